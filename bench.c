@@ -0,0 +1,441 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime(), fmemopen(), open_memstream()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "grafo.h"
+#include "gerador.h"
+
+//------------------------------------------------------------------------------
+// uso:
+//
+//   ./bench [-w aquecimento] [-r repetições] [-f csv|json] [-o operações]
+//           [-G n] arquivo.dot ...
+//
+// mede o tempo de cada operação de grafo.h sobre cada grafo: cada medida é
+// repetida aquecimento vezes sem contar (1, por padrão) e depois repetições
+// vezes (10, por padrão), e são escritos a mediana, o percentil 95, o mínimo
+// e a média, em milissegundos, em CSV (padrão) ou JSON
+//
+// -o restringe as medidas às operações listadas, separadas por vírgula
+// (por exemplo, -o cordal,simplicial)
+//
+// -G n acrescenta às entradas quatro grafos de gerador.h com n vértices,
+// sempre os mesmos: um cordal, um quase cordal (com 10 arestas extras), um
+// bipartido com emparelhamento perfeito (grau médio 4) e um com graus em lei
+// de potência (grau médio 8, expoente 2,5)
+//
+// os arquivos são lidos para a memória antes das medidas, de forma que
+// le_grafo() é medida sem o acesso ao disco
+
+//------------------------------------------------------------------------------
+// um grafo a medir: o texto dot e o que é preparado fora do tempo medido
+
+struct entrada {
+  const char *nome;
+  char *nome_gerado;          // nome alocado, para os grafos gerados
+  char *texto;
+  size_t tamanho;
+  grafo g;
+  unsigned int n;
+  unsigned int n_conjuntos;   // número de listas em conjuntos
+  lista *conjuntos;           // vizinhanças fechadas de alguns vértices, para clique()
+  lista ordem;                // busca em largura lexicográfica, para ordem_perfeita_eliminacao() e clique_maxima()
+  FILE *nulo;                 // destino de escreve_grafo()
+  int direcao;                // direção das vizinhanças: 0 ou 1 (grafo direcionado)
+  int padding; // só pra evitar warning
+};
+
+//------------------------------------------------------------------------------
+// número máximo de vizinhanças fechadas testadas por clique()
+
+#define MAX_CONJUNTOS 256
+
+//------------------------------------------------------------------------------
+// número de grafos gerados acrescentados por -G
+
+#define N_GERADOS 4
+
+//------------------------------------------------------------------------------
+//OPERAÇÕES MEDIDAS
+//------------------------------------------------------------------------------
+
+static void mede_le_grafo(struct entrada *e) {
+  FILE *f = fmemopen(e->texto, e->tamanho, "r");
+  destroi_grafo(le_grafo(f));
+  fclose(f);
+}
+
+static void mede_escreve_grafo(struct entrada *e) {
+  escreve_grafo(e->nulo, e->g);
+  fflush(e->nulo);
+}
+
+static void mede_copia_grafo(struct entrada *e) {
+  destroi_grafo(copia_grafo(e->g));
+}
+
+static void mede_vizinhanca(struct entrada *e) {
+  for (unsigned int i = 0; i < e->n; i++)
+    destroi_lista(vizinhanca(vertice_id(i, e->g), e->direcao, e->g), NULL);
+}
+
+static volatile unsigned int resultado; // impede que o compilador descarte as chamadas
+
+static void mede_grau(struct entrada *e) {
+  unsigned int soma = 0;
+  for (unsigned int i = 0; i < e->n; i++)
+    soma += grau(vertice_id(i, e->g), e->direcao, e->g);
+  resultado = soma;
+}
+
+static void mede_clique(struct entrada *e) {
+  unsigned int soma = 0;
+  for (unsigned int i = 0; i < e->n_conjuntos; i++)
+    soma += (unsigned int) clique(e->conjuntos[i], e->g);
+  resultado = soma;
+}
+
+static void mede_simplicial(struct entrada *e) {
+  unsigned int soma = 0;
+  for (unsigned int i = 0; i < e->n; i++)
+    soma += (unsigned int) simplicial(vertice_id(i, e->g), e->g);
+  resultado = soma;
+}
+
+static void mede_busca_largura_lexicografica(struct entrada *e) {
+  destroi_lista(busca_largura_lexicografica(e->g), NULL);
+}
+
+static void mede_busca_cardinalidade_maxima(struct entrada *e) {
+  destroi_lista(busca_cardinalidade_maxima(e->g), NULL);
+}
+
+static void mede_ordem_perfeita_eliminacao(struct entrada *e) {
+  resultado = (unsigned int) ordem_perfeita_eliminacao(e->ordem, e->g);
+}
+
+static void mede_cordal(struct entrada *e) {
+  resultado = (unsigned int) cordal(e->g);
+}
+
+static void mede_cordal_cardinalidade(struct entrada *e) {
+  resultado = (unsigned int) cordal_busca(e->g, BUSCA_CARDINALIDADE);
+}
+
+static void mede_clique_maxima(struct entrada *e) {
+  lista l = clique_maxima(e->ordem, e->g);
+  resultado = l ? tamanho_lista(l) : 0;
+  if ( l )
+    destroi_lista(l, NULL);
+}
+
+static void mede_emparelhamento_maximo(struct entrada *e) {
+  destroi_grafo(emparelhamento_maximo(e->g));
+}
+
+//------------------------------------------------------------------------------
+
+static const struct {
+  const char *nome;
+  void (*mede)(struct entrada *);
+} operacoes[] = {
+  { "le_grafo", mede_le_grafo },
+  { "escreve_grafo", mede_escreve_grafo },
+  { "copia_grafo", mede_copia_grafo },
+  { "vizinhanca", mede_vizinhanca },
+  { "grau", mede_grau },
+  { "clique", mede_clique },
+  { "simplicial", mede_simplicial },
+  { "busca_largura_lexicografica", mede_busca_largura_lexicografica },
+  { "busca_cardinalidade_maxima", mede_busca_cardinalidade_maxima },
+  { "ordem_perfeita_eliminacao", mede_ordem_perfeita_eliminacao },
+  { "cordal", mede_cordal },
+  { "cordal_cardinalidade", mede_cordal_cardinalidade },
+  { "clique_maxima", mede_clique_maxima },
+  { "emparelhamento_maximo", mede_emparelhamento_maximo },
+};
+
+#define N_OPERACOES (sizeof(operacoes) / sizeof(operacoes[0]))
+
+//------------------------------------------------------------------------------
+//ENTRADAS
+//------------------------------------------------------------------------------
+// lê todo o conteúdo do arquivo de nome arquivo para um buffer alocado,
+// devolvido com seu tamanho em *tamanho
+//
+// devolve o buffer ou
+//         NULL em caso de erro
+
+static char *le_arquivo(const char *arquivo, size_t *tamanho) {
+
+  FILE *f = fopen(arquivo, "rb");
+
+  if ( !f )
+    return NULL;
+
+  size_t capacidade = 1 << 16;
+  char *texto = malloc(capacidade);
+
+  *tamanho = 0;
+  while ( texto ) {
+    *tamanho += fread(texto + *tamanho, 1, capacidade - *tamanho, f);
+    if ( *tamanho < capacidade )
+      break;
+    char *maior = realloc(texto, 2 * capacidade);
+    if ( !maior ) {
+      free(texto);
+      texto = NULL;
+    }
+    else {
+      texto = maior;
+      capacidade *= 2;
+    }
+  }
+
+  if ( texto && ferror(f) ) {
+    free(texto);
+    texto = NULL;
+  }
+  fclose(f);
+  return texto;
+}
+
+//------------------------------------------------------------------------------
+// escreve em e->texto, no formato dot, o grafo gerado a (que é destruído),
+// com nome "gerado:tipo:n"
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+static int texto_gerado(struct entrada *e, grafo_gerado a, const char *tipo, unsigned int n) {
+
+  char *nome = malloc(strlen(tipo) + 32);
+  FILE *f = a && nome ? open_memstream(&e->texto, &e->tamanho) : NULL;
+  int ok = 0;
+
+  if ( nome )
+    sprintf(nome, "gerado:%s:%u", tipo, n);
+  e->nome = nome ? nome : tipo;
+  e->nome_gerado = nome;
+  if ( f ) {
+    ok = escreve_gerado(f, a, nome);
+    ok = fclose(f) == 0 && ok;
+  }
+  if ( !ok ) {
+    free(e->texto);
+    e->texto = NULL;
+  }
+  destroi_gerado(a);
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+// constrói o grafo de e a partir de seu texto e prepara os dados usados nas
+// medidas
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+static int prepara(struct entrada *e) {
+
+  FILE *f = e->tamanho ? fmemopen(e->texto, e->tamanho, "r") : NULL;
+
+  if ( !f )
+    return 0;
+  e->g = le_grafo(f);
+  fclose(f);
+  if ( !e->g )
+    return 0;
+
+  e->n = n_vertices(e->g);
+  e->direcao = direcionado(e->g) ? 1 : 0;
+  e->ordem = busca_largura_lexicografica(e->g);
+  e->nulo = fopen("/dev/null", "w");
+
+  // vizinhanças fechadas de até MAX_CONJUNTOS vértices espalhados pelos ids
+  e->n_conjuntos = e->n < MAX_CONJUNTOS ? e->n : MAX_CONJUNTOS;
+  e->conjuntos = malloc((e->n_conjuntos ? e->n_conjuntos : 1) * sizeof(lista));
+  if ( !e->ordem || !e->nulo || !e->conjuntos )
+    return 0;
+  for (unsigned int i = 0; i < e->n_conjuntos; i++) {
+    vertice v = vertice_id((unsigned int) ((unsigned long long) i * e->n / e->n_conjuntos), e->g);
+    e->conjuntos[i] = vizinhanca(v, e->direcao, e->g);
+    insere_lista(v, e->conjuntos[i]);
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+// desaloca o que prepara() alocou
+
+static void libera(struct entrada *e) {
+
+  for (unsigned int i = 0; e->conjuntos && i < e->n_conjuntos; i++)
+    destroi_lista(e->conjuntos[i], NULL);
+  free(e->conjuntos);
+  if ( e->ordem )
+    destroi_lista(e->ordem, NULL);
+  if ( e->nulo )
+    fclose(e->nulo);
+  destroi_grafo(e->g);
+  free(e->texto);
+  free(e->nome_gerado);
+}
+
+//------------------------------------------------------------------------------
+//MEDIDAS
+//------------------------------------------------------------------------------
+
+static double agora(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double) t.tv_sec * 1e3 + (double) t.tv_nsec * 1e-6;
+}
+
+static int compara_tempos(const void *a, const void *b) {
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+//------------------------------------------------------------------------------
+// escreve s entre aspas, escapando o que for preciso em CSV ou JSON
+
+static void escreve_texto(const char *s, int json) {
+
+  putchar('"');
+  for (; *s; s++) {
+    if ( *s == '"' )
+      fputs(json ? "\\\"" : "\"\"", stdout);
+    else if ( json && *s == '\\' )
+      fputs("\\\\", stdout);
+    else if ( json && (unsigned char) *s < 0x20 )
+      printf("\\u%04x", (unsigned int) (unsigned char) *s);
+    else
+      putchar(*s);
+  }
+  putchar('"');
+}
+
+//------------------------------------------------------------------------------
+// mede todas as operações selecionadas sobre e e escreve os resultados
+
+static void mede(struct entrada *e, unsigned int aquecimento, unsigned int repeticoes,
+                 const char *selecionadas, int json, double *tempos, int *primeiro) {
+
+  for (unsigned int o = 0; o < N_OPERACOES; o++) {
+    if ( selecionadas ) {
+      size_t t = strlen(operacoes[o].nome);
+      const char *p = selecionadas;
+      while ( (p = strstr(p, operacoes[o].nome)) )
+        if ( (p == selecionadas || p[-1] == ',') && (p[t] == ',' || p[t] == '\0') )
+          break;
+        else
+          p += t;
+      if ( !p )
+        continue;
+    }
+
+    for (unsigned int i = 0; i < aquecimento; i++)
+      operacoes[o].mede(e);
+    double soma = 0;
+    for (unsigned int i = 0; i < repeticoes; i++) {
+      double inicio = agora();
+      operacoes[o].mede(e);
+      tempos[i] = agora() - inicio;
+      soma += tempos[i];
+    }
+    qsort(tempos, repeticoes, sizeof(double), compara_tempos);
+
+    // percentis pelo posto mais próximo
+    double mediana = tempos[(repeticoes + 1) / 2 - 1];
+    double p95 = tempos[(95 * repeticoes + 99) / 100 - 1];
+
+    if ( json ) {
+      printf("%s\n  {\"arquivo\": ", *primeiro ? "" : ",");
+      escreve_texto(e->nome, 1);
+      printf(", \"vertices\": %u, \"arestas\": %u, \"operacao\": \"%s\", \"repeticoes\": %u, "
+             "\"mediana_ms\": %.6f, \"p95_ms\": %.6f, \"minimo_ms\": %.6f, \"media_ms\": %.6f}",
+             e->n, n_arestas(e->g), operacoes[o].nome, repeticoes,
+             mediana, p95, tempos[0], soma / repeticoes);
+    }
+    else {
+      escreve_texto(e->nome, 0);
+      printf(",%u,%u,%s,%u,%.6f,%.6f,%.6f,%.6f\n",
+             e->n, n_arestas(e->g), operacoes[o].nome, repeticoes,
+             mediana, p95, tempos[0], soma / repeticoes);
+    }
+    fflush(stdout);
+    *primeiro = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  unsigned int aquecimento = 1, repeticoes = 10, gerados = 0;
+  const char *selecionadas = NULL;
+  int json = 0;
+  int i = 1;
+
+  for (; i + 1 < argc && argv[i][0] == '-' && argv[i][1] && !argv[i][2]; i += 2) {
+    const char *valor = argv[i + 1];
+    switch ( argv[i][1] ) {
+    case 'w': aquecimento = (unsigned int) strtoul(valor, NULL, 10); break;
+    case 'r': repeticoes = (unsigned int) strtoul(valor, NULL, 10); break;
+    case 'f': json = !strcmp(valor, "json"); break;
+    case 'o': selecionadas = valor; break;
+    case 'G': gerados = (unsigned int) strtoul(valor, NULL, 10); break;
+    default:
+      fprintf(stderr, "opção desconhecida: %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if ( repeticoes == 0 )
+    repeticoes = 1;
+
+  unsigned int n_entradas = (unsigned int) (argc - i) + (gerados ? N_GERADOS : 0);
+  struct entrada *entradas = calloc(n_entradas ? n_entradas : 1, sizeof(struct entrada));
+  double *tempos = malloc(repeticoes * sizeof(double));
+  int falhas = 0, primeiro = 1;
+
+  if ( !entradas || !tempos )
+    return 1;
+
+  for (unsigned int j = 0; j < (unsigned int) (argc - i); j++) {
+    entradas[j].nome = argv[i + (int) j];
+    entradas[j].texto = le_arquivo(argv[i + (int) j], &entradas[j].tamanho);
+  }
+  if ( gerados ) {
+    struct entrada *e = entradas + n_entradas - N_GERADOS;
+    texto_gerado(e, gera_cordal(gerados, gerados, 4, 1), "cordal", gerados);
+    texto_gerado(e + 1, gera_quase_cordal(gerados, gerados, 4, 10, 1), "quase_cordal", gerados);
+    texto_gerado(e + 2, gera_bipartido_emparelhado(gerados / 2, 4, 1), "bipartido", gerados);
+    texto_gerado(e + 3, gera_lei_potencia(gerados, 8, 2.5, 1), "potencia", gerados);
+  }
+
+  if ( json )
+    printf("[");
+  else
+    printf("arquivo,vertices,arestas,operacao,repeticoes,mediana_ms,p95_ms,minimo_ms,media_ms\n");
+
+  for (unsigned int j = 0; j < n_entradas; j++) {
+    struct entrada *e = entradas + j;
+    if ( e->texto && prepara(e) )
+      mede(e, aquecimento, repeticoes, selecionadas, json, tempos, &primeiro);
+    else {
+      fprintf(stderr, "%s: grafo não pôde ser lido\n", e->nome);
+      falhas = 1;
+    }
+    libera(e);
+  }
+
+  if ( json )
+    printf("\n]\n");
+
+  free(tempos);
+  free(entradas);
+  return falhas;
+}
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+# uso: ./bench.sh [opções do bench] > resultado.csv
+
+./bench -G 100000 "$@" \
+	dot/*.dot \
+	dot/bipartite_graphs/*.dot
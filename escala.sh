@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# uso: ./escala.sh [n inicial (50000)] [dobras (5)] [operações (cordal,ordem_perfeita_eliminacao)]
+#
+# mede as operações do bench em grafos cordais gerados por gera com n, 2n,
+# 4n, ... vértices e escreve em CSV a mediana de cada medida e a razão para a
+# mesma medida no grafo com a metade dos vértices; num algoritmo linear a
+# razão fica perto de 2
+
+n=${1:-50000}
+dobras=${2:-5}
+operacoes=${3:-cordal,ordem_perfeita_eliminacao}
+dot=$(mktemp) || exit 1
+trap 'rm -f "$dot"' EXIT
+
+echo "vertices,arestas,operacao,mediana_ms,razao"
+for (( i = 0; i < dobras; i++ )); do
+	./gera cordal $n > "$dot" || exit 1
+	./bench -o "$operacoes" "$dot" | tail -n +2
+	n=$(( 2 * n ))
+done | awk -F, '{
+	razao = ($4 in anterior && anterior[$4] > 0) ? sprintf("%.2f", $6 / anterior[$4]) : "";
+	anterior[$4] = $6;
+	print $2 "," $3 "," $4 "," $6 "," razao;
+}'
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gerador.h"
+
+//------------------------------------------------------------------------------
+// uso:
+//
+//   ./gera [-s semente] tipo n [parâmetros]
+//
+// escreve na saída padrão, em formato dot, um grafo aleatório de gerador.h;
+// a mesma semente (1, por padrão) produz sempre o mesmo grafo
+//
+//   cordal n [nós da árvore (n)] [tamanho máximo das subárvores (4)]
+//   quase_cordal n [nós da árvore (n)] [tamanho máximo (4)] [arestas extras (10)]
+//   bipartido n [grau médio (4)]            (2n vértices, emparelhamento perfeito)
+//   potencia n [grau médio (8)] [expoente (2.5)]
+
+//------------------------------------------------------------------------------
+// devolve o parâmetro i de argv (de argc elementos) ou padrao, se não há
+
+static unsigned int parametro(int argc, char **argv, int i, unsigned int padrao) {
+  return i < argc ? (unsigned int) strtoul(argv[i], NULL, 10) : padrao;
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  unsigned long long semente = 1;
+  int i = 1;
+
+  if ( i + 1 < argc && !strcmp(argv[i], "-s") ) {
+    semente = strtoull(argv[i + 1], NULL, 10);
+    i += 2;
+  }
+  if ( i + 1 >= argc ) {
+    fprintf(stderr, "uso: %s [-s semente] cordal|quase_cordal|bipartido|potencia n [parâmetros]\n", argv[0]);
+    return 1;
+  }
+
+  const char *tipo = argv[i];
+  unsigned int n = parametro(argc, argv, i + 1, 0);
+  grafo_gerado a = NULL;
+
+  i += 2;
+  if ( !strcmp(tipo, "cordal") )
+    a = gera_cordal(n, parametro(argc, argv, i, n), parametro(argc, argv, i + 1, 4), semente);
+  else if ( !strcmp(tipo, "quase_cordal") )
+    a = gera_quase_cordal(n, parametro(argc, argv, i, n), parametro(argc, argv, i + 1, 4),
+                          parametro(argc, argv, i + 2, 10), semente);
+  else if ( !strcmp(tipo, "bipartido") )
+    a = gera_bipartido_emparelhado(n, parametro(argc, argv, i, 4), semente);
+  else if ( !strcmp(tipo, "potencia") )
+    a = gera_lei_potencia(n, parametro(argc, argv, i, 8),
+                          i + 1 < argc ? strtod(argv[i + 1], NULL) : 2.5, semente);
+  else {
+    fprintf(stderr, "tipo desconhecido: %s\n", tipo);
+    return 1;
+  }
+
+  if ( !a ) {
+    fprintf(stderr, "grafo não pôde ser gerado\n");
+    return 1;
+  }
+
+  int ok = escreve_gerado(stdout, a, tipo);
+
+  return ! (destroi_gerado(a) && ok);
+}
@@ -0,0 +1,609 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "gerador.h"
+
+//------------------------------------------------------------------------------
+//SORTEIO
+//------------------------------------------------------------------------------
+// gerador pseudo-aleatório xorshift64*, com o estado inicial derivado da
+// semente por splitmix64 (de forma que sementes próximas dão sequências
+// independentes e o estado nunca é 0)
+
+struct sorteio {
+    uint64_t estado;
+};
+
+static void inicia_sorteio(struct sorteio *s, unsigned long long semente){
+    uint64_t z = (uint64_t) semente + 0x9e3779b97f4a7c15ull;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    s->estado = z ? z : 1;
+}
+
+static uint64_t sorteia_64(struct sorteio *s){
+    s->estado ^= s->estado >> 12;
+    s->estado ^= s->estado << 25;
+    s->estado ^= s->estado >> 27;
+    return s->estado * 0x2545f4914f6cdd1dull;
+}
+
+//------------------------------------------------------------------------------
+// devolve um inteiro sorteado em [0, limite), limite > 0
+
+static unsigned int sorteia(struct sorteio *s, unsigned int limite){
+    return (unsigned int) (((sorteia_64(s) >> 32) * limite) >> 32);
+}
+
+//------------------------------------------------------------------------------
+// devolve um real sorteado em [0, 1)
+
+static double sorteia_real(struct sorteio *s){
+    return (double) (sorteia_64(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//------------------------------------------------------------------------------
+// embaralha p[0..n-1] (Fisher-Yates)
+
+static void embaralha(unsigned int *p, unsigned int n, struct sorteio *s){
+    for(unsigned int i = n; i > 1; i--){
+        unsigned int j = sorteia(s, i);
+        unsigned int t = p[i - 1];
+        p[i - 1] = p[j];
+        p[j] = t;
+    }
+}
+
+//------------------------------------------------------------------------------
+//LISTA DE ARESTAS
+//------------------------------------------------------------------------------
+// cria e devolve um grafo gerado com n vertices, sem arestas e com espaço
+// para capacidade arestas, ou
+//         NULL em caso de falta de memória
+
+static grafo_gerado cria_gerado(unsigned int n, size_t capacidade){
+    grafo_gerado a = malloc(sizeof(struct grafo_gerado));
+
+    if(!a)
+        return NULL;
+    a->n_vertices = n;
+    a->n_arestas = 0;
+    a->origem = malloc((capacidade ? capacidade : 1) * sizeof(unsigned int));
+    a->destino = malloc((capacidade ? capacidade : 1) * sizeof(unsigned int));
+    if(!a->origem || !a->destino){
+        destroi_gerado(a);
+        return NULL;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// muda a capacidade de a para capacidade arestas (>= a->n_arestas)
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int redimensiona(grafo_gerado a, size_t capacidade){
+    unsigned int *origem = realloc(a->origem, (capacidade ? capacidade : 1) * sizeof(unsigned int));
+
+    if(origem)
+        a->origem = origem;
+
+    unsigned int *destino = realloc(a->destino, (capacidade ? capacidade : 1) * sizeof(unsigned int));
+
+    if(destino)
+        a->destino = destino;
+    return origem && destino;
+}
+
+//------------------------------------------------------------------------------
+// orienta cada aresta de a do menor para o maior id, ordena as arestas pela
+// origem (por contagem, de forma estável) e remove os laços e as repetições,
+// em O(V+E)
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int normaliza(grafo_gerado a){
+    unsigned int n = a->n_vertices, m = a->n_arestas;
+    unsigned int *inicio = calloc((size_t) n + 1, sizeof(unsigned int));
+    unsigned int *marca = calloc(n ? n : 1, sizeof(unsigned int));
+    unsigned int *origem = malloc((m ? m : 1) * sizeof(unsigned int));
+    unsigned int *destino = malloc((m ? m : 1) * sizeof(unsigned int));
+
+    if(!inicio || !marca || !origem || !destino){
+        free(inicio);
+        free(marca);
+        free(origem);
+        free(destino);
+        return 0;
+    }
+
+    for(unsigned int k = 0; k < m; k++){
+        unsigned int u = a->origem[k], w = a->destino[k];
+        if(u != w)
+            inicio[(u < w ? u : w) + 1]++;
+    }
+    for(unsigned int u = 0; u < n; u++)
+        inicio[u + 1] += inicio[u];
+
+    // destino[inicio[u]++] recebe os vizinhos maiores que u; ao final
+    // inicio[u] é o fim do intervalo de u, e é deslocado de volta
+    for(unsigned int k = 0; k < m; k++){
+        unsigned int u = a->origem[k], w = a->destino[k];
+        if(u < w)
+            destino[inicio[u]++] = w;
+        else if(w < u)
+            destino[inicio[w]++] = u;
+    }
+    for(unsigned int u = n; u > 0; u--)
+        inicio[u] = inicio[u - 1];
+    inicio[0] = 0;
+
+    // marca[w] == u+1 se a aresta {u,w} já foi mantida
+    unsigned int mantidas = 0;
+    for(unsigned int u = 0; u < n; u++)
+        for(unsigned int j = inicio[u]; j < inicio[u + 1]; j++){
+            unsigned int w = destino[j];
+            if(marca[w] != u + 1){
+                marca[w] = u + 1;
+                origem[mantidas] = u;
+                destino[mantidas++] = w;
+            }
+        }
+
+    free(inicio);
+    free(marca);
+    free(a->origem);
+    free(a->destino);
+    a->origem = origem;
+    a->destino = destino;
+    a->n_arestas = mantidas;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//GERADORES
+//------------------------------------------------------------------------------
+// acrescenta os filhos do nó x da árvore (filhos[inicio[x] .. inicio[x+1]-1])
+// à fronteira *fronteira, de *n_fronteira elementos e capacidade *tam
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int acrescenta_filhos(unsigned int x, const unsigned int *inicio, const unsigned int *filhos,
+                             unsigned int **fronteira, unsigned int *n_fronteira, unsigned int *tam){
+    for(unsigned int j = inicio[x]; j < inicio[x + 1]; j++){
+        if(*n_fronteira == *tam){
+            unsigned int *maior = realloc(*fronteira, 2 * *tam * sizeof(unsigned int));
+            if(!maior)
+                return 0;
+            *fronteira = maior;
+            *tam *= 2;
+        }
+        (*fronteira)[(*n_fronteira)++] = filhos[j];
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// a árvore tem nos_arvore nós; o pai do nó x > 0 é sorteado entre os nós
+// 0..x-1, de forma que 0 é a raiz e todo nó vem depois de seu pai
+//
+// cada vértice v escolhe um nó raiz[v] e um tamanho, e sua subárvore cresce
+// para baixo a partir de raiz[v], acrescentando a cada passo um filho
+// sorteado entre os dos nós já escolhidos; raiz[v] é o nó da subárvore mais
+// próximo da raiz da árvore
+//
+// a interseção de duas subárvores, se não é vazia, é uma subárvore cujo nó
+// mais alto é a mais baixa das duas raízes; assim cada aresta {u,v} é
+// gerada uma única vez, no nó x = raiz[u] (ou raiz[v]), pelo vértice cuja
+// raiz é x, ao percorrer os vértices cujas subárvores contêm x
+
+grafo_gerado gera_cordal(unsigned int n, unsigned int nos_arvore, unsigned int tamanho_max,
+                         unsigned long long semente){
+    unsigned int t = nos_arvore ? nos_arvore : (n ? n : 1);
+    struct sorteio s;
+
+    if(tamanho_max == 0)
+        tamanho_max = 1;
+    if(tamanho_max > t)
+        tamanho_max = t;
+    if((uint64_t) n * tamanho_max > UINT_MAX)
+        return NULL;
+    inicia_sorteio(&s, semente);
+
+    unsigned int *inicio_filhos = calloc((size_t) t + 1, sizeof(unsigned int));
+    unsigned int *filhos = malloc(t * sizeof(unsigned int));
+    unsigned int *pai = malloc(t * sizeof(unsigned int));
+    unsigned int *raiz = malloc((n ? n : 1) * sizeof(unsigned int));
+    unsigned int *membro = malloc((size_t) (n ? n : 1) * tamanho_max * sizeof(unsigned int));
+    unsigned int *inicio_bolsa = calloc((size_t) t + 1, sizeof(unsigned int));
+    unsigned int *bolsa = NULL;
+    unsigned int tam_fronteira = 64, n_fronteira;
+    unsigned int *fronteira = malloc(tam_fronteira * sizeof(unsigned int));
+    grafo_gerado a = NULL;
+    int ok = inicio_filhos && filhos && pai && raiz && membro && inicio_bolsa && fronteira;
+
+    // árvore, com os filhos de cada nó em CSR
+    for(unsigned int x = 1; ok && x < t; x++){
+        pai[x] = sorteia(&s, x);
+        inicio_filhos[pai[x] + 1]++;
+    }
+    for(unsigned int x = 0; ok && x < t; x++)
+        inicio_filhos[x + 1] += inicio_filhos[x];
+    for(unsigned int x = 1; ok && x < t; x++)
+        filhos[inicio_filhos[pai[x]]++] = x;
+    for(unsigned int x = t; ok && x > 0; x--)
+        inicio_filhos[x] = inicio_filhos[x - 1];
+    if(ok)
+        inicio_filhos[0] = 0;
+
+    // subárvores: a de v é membro[v*tamanho_max .. v*tamanho_max+tamanho[v]-1],
+    // e inicio_bolsa conta quantas subárvores contêm cada nó
+    unsigned int total = 0;
+    for(unsigned int v = 0; ok && v < n; v++){
+        unsigned int tamanho = 1 + sorteia(&s, tamanho_max);
+        unsigned int *m = membro + (size_t) v * tamanho_max;
+        unsigned int k = 0;
+
+        raiz[v] = sorteia(&s, t);
+        m[k++] = raiz[v];
+        n_fronteira = 0;
+        ok = acrescenta_filhos(raiz[v], inicio_filhos, filhos, &fronteira, &n_fronteira, &tam_fronteira);
+        while(ok && k < tamanho && n_fronteira > 0){
+            unsigned int i = sorteia(&s, n_fronteira);
+            unsigned int x = fronteira[i];
+            fronteira[i] = fronteira[--n_fronteira];
+            m[k++] = x;
+            ok = acrescenta_filhos(x, inicio_filhos, filhos, &fronteira, &n_fronteira, &tam_fronteira);
+        }
+        for(unsigned int j = 0; j < k; j++)
+            inicio_bolsa[m[j] + 1]++;
+        total += k;
+        if(k < tamanho_max)
+            m[k] = UINT_MAX; // fim da subárvore
+    }
+
+    // bolsa de cada nó x: os vértices cujas subárvores contêm x, em
+    // bolsa[inicio_bolsa[x] .. inicio_bolsa[x+1]-1]
+    if(ok)
+        ok = (bolsa = malloc((total ? total : 1) * sizeof(unsigned int))) != NULL;
+    for(unsigned int x = 0; ok && x < t; x++)
+        inicio_bolsa[x + 1] += inicio_bolsa[x];
+    for(unsigned int v = 0; ok && v < n; v++){
+        unsigned int *m = membro + (size_t) v * tamanho_max;
+        for(unsigned int j = 0; j < tamanho_max && m[j] != UINT_MAX; j++)
+            bolsa[inicio_bolsa[m[j]]++] = v;
+    }
+    for(unsigned int x = t; ok && x > 0; x--)
+        inicio_bolsa[x] = inicio_bolsa[x - 1];
+    if(ok)
+        inicio_bolsa[0] = 0;
+
+    // conta e depois gera as arestas
+    uint64_t n_arestas = 0;
+    for(unsigned int x = 0; ok && x < t; x++)
+        for(unsigned int i = inicio_bolsa[x]; i < inicio_bolsa[x + 1]; i++){
+            unsigned int u = bolsa[i];
+            if(raiz[u] != x)
+                continue;
+            for(unsigned int j = inicio_bolsa[x]; j < inicio_bolsa[x + 1]; j++)
+                if(bolsa[j] != u && (raiz[bolsa[j]] != x || bolsa[j] > u))
+                    n_arestas++;
+        }
+    if(n_arestas > UINT_MAX / 2)
+        ok = 0;
+    if(ok)
+        ok = (a = cria_gerado(n, (size_t) n_arestas)) != NULL;
+    for(unsigned int x = 0; ok && x < t; x++)
+        for(unsigned int i = inicio_bolsa[x]; i < inicio_bolsa[x + 1]; i++){
+            unsigned int u = bolsa[i];
+            if(raiz[u] != x)
+                continue;
+            for(unsigned int j = inicio_bolsa[x]; j < inicio_bolsa[x + 1]; j++)
+                if(bolsa[j] != u && (raiz[bolsa[j]] != x || bolsa[j] > u)){
+                    a->origem[a->n_arestas] = u;
+                    a->destino[a->n_arestas++] = bolsa[j];
+                }
+        }
+    if(ok)
+        ok = normaliza(a);
+
+    free(inicio_filhos);
+    free(filhos);
+    free(pai);
+    free(raiz);
+    free(membro);
+    free(inicio_bolsa);
+    free(bolsa);
+    free(fronteira);
+    if(!ok){
+        destroi_gerado(a);
+        return NULL;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// sorteia um vértice a distância exatamente 3 de u no grafo de vizinhanças
+// vizinho[inicio[v] .. inicio[v+1]-1], por uma busca em largura limitada a
+// 3 níveis; marca[] é zerada a cada busca pelo carimbo *carimbo
+//
+// devolve o vértice sorteado ou
+//         UINT_MAX se não há vértice a distância 3 de u
+
+static unsigned int sorteia_distancia_3(unsigned int u, const unsigned int *inicio, const unsigned int *vizinho,
+                                        unsigned int *marca, unsigned int *carimbo, unsigned int *fila,
+                                        struct sorteio *s){
+    unsigned int ini = 0, fim = 0, nivel_fim = 1;
+
+    (*carimbo)++;
+    marca[u] = *carimbo;
+    fila[fim++] = u;
+
+    // fila[0 .. nivel_fim-1] tem os níveis já completos
+    for(unsigned int nivel = 0; nivel < 3 && ini < fim; nivel++){
+        for(nivel_fim = fim; ini < nivel_fim; ini++)
+            for(unsigned int j = inicio[fila[ini]]; j < inicio[fila[ini] + 1]; j++)
+                if(marca[vizinho[j]] != *carimbo){
+                    marca[vizinho[j]] = *carimbo;
+                    fila[fim++] = vizinho[j];
+                }
+    }
+    // o nível 3 é fila[nivel_fim .. fim-1]
+    return fim > nivel_fim ? fila[nivel_fim + sorteia(s, fim - nivel_fim)] : UINT_MAX;
+}
+
+//------------------------------------------------------------------------------
+// cada aresta extra liga um vértice u sorteado a um vértice sorteado entre
+// os que estão a distância 3 de u no grafo cordal, criando um ciclo u a b v
+// sem cordas (as cordas {u,b} e {a,v} ligariam vértices a distância 2, e
+// nunca são escolhidas); assim o grafo não é cordal se ao menos uma aresta
+// extra foi acrescentada
+//
+// u é sorteado até MAX_TENTATIVAS vezes por aresta; as arestas repetidas são
+// descartadas por normaliza() e sorteadas de novo, em até MAX_RODADAS rodadas
+
+#define MAX_TENTATIVAS 16
+#define MAX_RODADAS 8
+
+grafo_gerado gera_quase_cordal(unsigned int n, unsigned int nos_arvore, unsigned int tamanho_max,
+                               unsigned int extras, unsigned long long semente){
+    grafo_gerado a = gera_cordal(n, nos_arvore, tamanho_max, semente);
+    struct sorteio s;
+
+    if(!a || n < 4 || extras == 0)
+        return a;
+    inicia_sorteio(&s, ~semente);
+
+    // vizinhanças do grafo cordal em CSR
+    unsigned int m = a->n_arestas;
+    unsigned int *inicio = calloc((size_t) n + 1, sizeof(unsigned int));
+    unsigned int *vizinho = malloc(2 * (size_t) (m ? m : 1) * sizeof(unsigned int));
+    unsigned int *marca = calloc(n, sizeof(unsigned int));
+    unsigned int *fila = malloc(n * sizeof(unsigned int));
+    unsigned int carimbo = 0;
+    uint64_t alvo = (uint64_t) m + extras;
+    int ok = inicio && vizinho && marca && fila && alvo <= UINT_MAX / 2 && redimensiona(a, (size_t) alvo);
+
+    for(unsigned int k = 0; ok && k < m; k++){
+        inicio[a->origem[k] + 1]++;
+        inicio[a->destino[k] + 1]++;
+    }
+    for(unsigned int v = 0; ok && v < n; v++)
+        inicio[v + 1] += inicio[v];
+    for(unsigned int k = 0; ok && k < m; k++){
+        vizinho[inicio[a->origem[k]]++] = a->destino[k];
+        vizinho[inicio[a->destino[k]]++] = a->origem[k];
+    }
+    for(unsigned int v = n; ok && v > 0; v--)
+        inicio[v] = inicio[v - 1];
+    if(ok)
+        inicio[0] = 0;
+
+    for(unsigned int rodada = 0; ok && a->n_arestas < alvo && rodada < MAX_RODADAS; rodada++){
+        unsigned int antes = a->n_arestas;
+        for(unsigned int faltam = (unsigned int) (alvo - antes); faltam > 0; faltam--)
+            for(unsigned int tentativa = 0; tentativa < MAX_TENTATIVAS; tentativa++){
+                if(carimbo == UINT_MAX){
+                    memset(marca, 0, n * sizeof(unsigned int));
+                    carimbo = 0;
+                }
+                unsigned int u = sorteia(&s, n);
+                unsigned int v = sorteia_distancia_3(u, inicio, vizinho, marca, &carimbo, fila, &s);
+                if(v != UINT_MAX){
+                    a->origem[a->n_arestas] = u;
+                    a->destino[a->n_arestas++] = v;
+                    break;
+                }
+            }
+        if(a->n_arestas == antes)
+            break;
+        ok = normaliza(a) && redimensiona(a, (size_t) alvo);
+    }
+
+    free(inicio);
+    free(vizinho);
+    free(marca);
+    free(fila);
+    if(!ok){
+        destroi_gerado(a);
+        return NULL;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+
+grafo_gerado gera_bipartido_emparelhado(unsigned int n, unsigned int grau_medio,
+                                        unsigned long long semente){
+    struct sorteio s;
+
+    if(grau_medio == 0)
+        grau_medio = 1;
+    if(n > INT_MAX / 2 || (uint64_t) n * grau_medio > UINT_MAX / 2)
+        return NULL;
+    inicia_sorteio(&s, semente);
+
+    grafo_gerado a = cria_gerado(2 * n, (size_t) n * grau_medio);
+    unsigned int *p = malloc((n ? n : 1) * sizeof(unsigned int));
+
+    if(!a || !p){
+        free(p);
+        destroi_gerado(a);
+        return NULL;
+    }
+
+    for(unsigned int i = 0; i < n; i++)
+        p[i] = i;
+    embaralha(p, n, &s);
+
+    for(unsigned int i = 0; i < n; i++){
+        a->origem[a->n_arestas] = i;
+        a->destino[a->n_arestas++] = n + p[i];
+        for(unsigned int j = 1; j < grau_medio; j++){
+            a->origem[a->n_arestas] = i;
+            a->destino[a->n_arestas++] = n + sorteia(&s, n);
+        }
+    }
+    free(p);
+
+    if(!normaliza(a)){
+        destroi_gerado(a);
+        return NULL;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// cada extremidade é sorteada em O(1) pelo método dos apelidos (Vose): o
+// vértice i é sorteado com probabilidade uniforme e mantido com
+// probabilidade chance[i], ou trocado por apelido[i]
+
+grafo_gerado gera_lei_potencia(unsigned int n, unsigned int grau_medio, double expoente,
+                               unsigned long long semente){
+    struct sorteio s;
+    uint64_t pares = (uint64_t) n * grau_medio / 2;
+
+    if(!(expoente > 2) || pares > UINT_MAX / 2)
+        return NULL;
+    inicia_sorteio(&s, semente);
+
+    grafo_gerado a = cria_gerado(n, (size_t) pares);
+    double *chance = malloc((n ? n : 1) * sizeof(double));
+    unsigned int *apelido = malloc((n ? n : 1) * sizeof(unsigned int));
+    unsigned int *pilha = malloc((n ? n : 1) * sizeof(unsigned int));
+    unsigned int *rotulo = malloc((n ? n : 1) * sizeof(unsigned int));
+
+    if(!a || !chance || !apelido || !pilha || !rotulo){
+        free(chance);
+        free(apelido);
+        free(pilha);
+        free(rotulo);
+        destroi_gerado(a);
+        return NULL;
+    }
+
+    double soma = 0, alfa = -1 / (expoente - 1);
+    for(unsigned int i = 0; i < n; i++){
+        chance[i] = pow((double) i + 1, alfa);
+        soma += chance[i];
+        apelido[i] = i;
+        rotulo[i] = i;
+    }
+    embaralha(rotulo, n, &s);
+
+    // pilha[0 .. pequenos-1] tem os vértices com chance < 1 e
+    // pilha[grandes .. n-1] os com chance >= 1; cada pequeno é completado
+    // com a sobra de um grande
+    unsigned int pequenos = 0, grandes = n;
+    for(unsigned int i = 0; i < n; i++){
+        chance[i] *= n / soma;
+        if(chance[i] < 1)
+            pilha[pequenos++] = i;
+        else
+            pilha[--grandes] = i;
+    }
+    while(pequenos > 0 && grandes < n){
+        unsigned int p = pilha[--pequenos], g = pilha[grandes++];
+        apelido[p] = g;
+        chance[g] -= 1 - chance[p];
+        if(chance[g] < 1)
+            pilha[pequenos++] = g;
+        else
+            pilha[--grandes] = g;
+    }
+
+    for(uint64_t k = 0; n > 1 && k < pares; k++){
+        unsigned int u = sorteia(&s, n), w = sorteia(&s, n);
+        if(sorteia_real(&s) >= chance[u])
+            u = apelido[u];
+        if(sorteia_real(&s) >= chance[w])
+            w = apelido[w];
+        a->origem[a->n_arestas] = rotulo[u];
+        a->destino[a->n_arestas++] = rotulo[w];
+    }
+    free(chance);
+    free(apelido);
+    free(pilha);
+    free(rotulo);
+
+    if(!normaliza(a)){
+        destroi_gerado(a);
+        return NULL;
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+//SAÍDA
+//------------------------------------------------------------------------------
+
+grafo converte_gerado(grafo_gerado a, const char *nome){
+    if(!a || !nome)
+        return NULL;
+
+    return constroi_grafo(nome, 0, a->n_vertices, a->n_arestas, a->origem, a->destino, NULL);
+}
+
+//------------------------------------------------------------------------------
+// o nome do grafo é escrito entre aspas, com '"' e '\' escapados
+
+int escreve_gerado(FILE *output, grafo_gerado a, const char *nome){
+    if(!output || !a || !nome)
+        return 0;
+
+    fputs("strict graph \"", output);
+    for(const char *c = nome; *c; c++){
+        if(*c == '"' || *c == '\\')
+            fputc('\\', output);
+        fputc(*c, output);
+    }
+    fputs("\" {\n", output);
+
+    for(unsigned int v = 0; v < a->n_vertices; v++)
+        fprintf(output, "\t%u;\n", v);
+    for(unsigned int k = 0; k < a->n_arestas; k++)
+        fprintf(output, "\t%u -- %u;\n", a->origem[k], a->destino[k]);
+    fputs("}\n", output);
+
+    return !ferror(output);
+}
+
+//------------------------------------------------------------------------------
+
+int destroi_gerado(grafo_gerado a){
+    if(!a)
+        return 0;
+
+    free(a->origem);
+    free(a->destino);
+    free(a);
+    return 1;
+}
@@ -0,0 +1,109 @@
+#ifndef _GERADOR_H
+#define _GERADOR_H
+
+#include <stdio.h>
+#include "grafo.h"
+
+//------------------------------------------------------------------------------
+// geradores de grafos não direcionados aleatórios, para testes de escala
+//
+// todos os geradores são determinísticos: a mesma semente produz sempre o
+// mesmo grafo; o grafo gerado é uma lista de arestas sem laços nem
+// repetições, ordenada pela origem (origem[k] < destino[k]), que pode ser
+// convertida num grafo (converte_gerado()) ou escrita em formato dot
+// (escreve_gerado()) sem passar pela libcgraph
+
+//------------------------------------------------------------------------------
+// (apontador para) grafo gerado: n_vertices vértices, de ids 0 a
+// n_vertices-1, e n_arestas arestas {origem[k], destino[k]}
+
+typedef struct grafo_gerado {
+    unsigned int n_vertices;
+    unsigned int n_arestas;
+    unsigned int *origem;
+    unsigned int *destino;
+} *grafo_gerado;
+
+//------------------------------------------------------------------------------
+// devolve um grafo cordal aleatório com n vértices, gerado como grafo de
+// interseção de subárvores: cada vértice é uma subárvore de até tamanho_max
+// nós, sorteada numa árvore aleatória de nos_arvore nós (n, se
+// nos_arvore == 0), e dois vértices são vizinhos se suas subárvores se
+// intersectam
+//
+// quanto menor nos_arvore e maior tamanho_max, mais denso é o grafo
+//
+// devolve NULL em caso de falta de memória ou se o grafo teria mais de
+// UINT_MAX/2 arestas
+
+grafo_gerado gera_cordal(unsigned int n, unsigned int nos_arvore, unsigned int tamanho_max,
+                         unsigned long long semente);
+
+//------------------------------------------------------------------------------
+// devolve um grafo quase cordal: o grafo de gera_cordal() com os mesmos
+// parâmetros acrescido de até extras arestas, cada uma entre vértices a
+// distância 3 no grafo cordal (menos, se há poucos pares assim)
+//
+// cada aresta extra cria um ciclo de tamanho 4 sem cordas, de forma que o
+// grafo não é cordal se alguma aresta foi acrescentada
+//
+// devolve NULL em caso de falta de memória
+
+grafo_gerado gera_quase_cordal(unsigned int n, unsigned int nos_arvore, unsigned int tamanho_max,
+                               unsigned int extras, unsigned long long semente);
+
+//------------------------------------------------------------------------------
+// devolve um grafo bipartido aleatório com 2n vértices, os de ids 0 a n-1 de
+// um lado e os de ids n a 2n-1 do outro, com um emparelhamento perfeito
+// plantado (cada vértice i < n é vizinho de um n+p(i), p uma permutação
+// sorteada) e, além dele, grau_medio-1 vizinhos sorteados para cada i < n
+// (menos, quando o sorteio repete um vizinho)
+//
+// o emparelhamento máximo do grafo tem exatamente n arestas
+//
+// devolve NULL em caso de falta de memória
+
+grafo_gerado gera_bipartido_emparelhado(unsigned int n, unsigned int grau_medio,
+                                        unsigned long long semente);
+
+//------------------------------------------------------------------------------
+// devolve um grafo aleatório com n vértices cujos graus seguem uma lei de
+// potência de expoente expoente (> 2; tipicamente entre 2 e 3), pelo modelo
+// de Chung-Lu: são sorteados n*grau_medio/2 pares de vértices, cada vértice
+// com probabilidade proporcional a um peso esperado (i+1)^(-1/(expoente-1)),
+// e descartados os laços e as repetições
+//
+// os ids são embaralhados, de forma que o grau não depende do id
+//
+// devolve NULL em caso de falta de memória ou de parâmetros inválidos
+
+grafo_gerado gera_lei_potencia(unsigned int n, unsigned int grau_medio, double expoente,
+                               unsigned long long semente);
+
+//------------------------------------------------------------------------------
+// devolve um grafo não direcionado de nome nome com os vértices e arestas
+// de a (o vértice de id i tem nome "i"), construído com constroi_grafo(), ou
+//         NULL em caso de erro
+
+grafo converte_gerado(grafo_gerado a, const char *nome);
+
+//------------------------------------------------------------------------------
+// escreve a em output no formato dot, como um grafo estrito de nome nome:
+// primeiro os vértices, em ordem de id, depois as arestas
+//
+// le_grafo() do texto escrito devolve o mesmo grafo que converte_gerado()
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int escreve_gerado(FILE *output, grafo_gerado a, const char *nome);
+
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada por a
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int destroi_gerado(grafo_gerado a);
+
+#endif
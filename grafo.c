@@ -1,16 +1,60 @@
+#define _POSIX_C_SOURCE 200809L // fmemopen(), fileno(), mmap()
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <limits.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BITSET_AVX2 1 // kernels AVX2, escolhidos em tempo de execução
+#endif
 #include <graphviz/cgraph.h>
 #include "grafo.h"
 #include <malloc.h>
  
-// tamanho máximo da string para representar o peso de uma aresta/arco
-#define MAX_STRING_SIZE 256
+// número máximo de vertices para que clique() e simplicial() construam
+// automaticamente a matriz de adjacência em bits (n*n/8 bytes); pode ser
+// mudado na compilação (-DLIMITE_BITSET=...), e 0 desliga a construção
+// automática (constroi_bitset() continua disponível)
+#ifndef LIMITE_BITSET
+#define LIMITE_BITSET 8192
+#endif
+
+// a libcgraph não é reentrante: toda sequência de chamadas a ela (de agread()
+// até agclose()) é feita com esta trava, para que le_grafo() possa ser usada
+// em várias threads
+static pthread_mutex_t trava_cgraph = PTHREAD_MUTEX_INITIALIZER;
 //------------------------------------------------------------------------------
 //ESTRUTURAS
 //------------------------------------------------------------------------------
+//ARENA
+//------------------------------------------------------------------------------
+// bloco de memória de uma arena; os dados vêm logo depois do cabeçalho
+
+struct bloco_arena {
+    struct bloco_arena *anterior; // bloco alocado antes deste, ou NULL
+    size_t tamanho; // bytes disponíveis depois do cabeçalho
+};
+//------------------------------------------------------------------------------
+// arena: alocador por incremento de apontador ("bump allocator")
+//
+// cada alocação só avança livre dentro do bloco atual; quando o bloco
+// acaba é alocado outro, com o dobro do tamanho; nada é desalocado
+// individualmente, e a arena inteira é desalocada de uma vez, bloco a bloco
+
+struct arena {
+    struct bloco_arena *bloco; // bloco atual, ou NULL
+    char *livre; // próxima posição livre do bloco atual
+    char *fim; // fim do bloco atual
+    size_t tam_bloco; // tamanho do próximo bloco a ser alocado
+};
+//------------------------------------------------------------------------------
 //LISTA
 //------------------------------------------------------------------------------
 // nó de lista encadeada cujo conteúdo é um void *
@@ -26,6 +70,9 @@ struct lista {
     unsigned int tamanho;
     int padding; // só pra evitar warning 
     no primeiro;
+    no livres; // nós removidos, reaproveitados por insere_lista()
+    struct arena *arena; // de onde vêm a lista e seus nós: &propria, ou a arena de construção de um grafo
+    struct arena propria; // arena da própria lista (listas devolvidas ao usuário)
 };
 //------------------------------------------------------------------------------
 //GRAFO
@@ -47,7 +94,42 @@ struct grafo{
     int ponderado; // 1, se o grafo tem pesos nas arestas/arcos, 0 se não é
     unsigned int n_vertices; //numero de vertices
     unsigned int n_arestas; //numero de arestas
+    unsigned int capacidade; //tamanho alocado do vetor de vertices
+    int congelado; // 1, se as adjacências já estão no formato CSR (ver congela_grafo()), 0 se não
     vertice *vertices; //apontador para a estrutura de vertices
+    unsigned int *indice; //tabela hash nome -> id+1 (0 = posição livre), endereçamento aberto
+    unsigned int tam_indice; //tamanho da tabela hash, sempre uma potência de 2
+    int padding; // só pra evitar warning
+    struct arena memoria; // vertices e nomes, desalocada só por destroi_grafo()
+    struct arena construcao; // listas de adjacência, desalocada por congela_grafo()
+    uint64_t *bits; // matriz de adjacência em bits, n linhas de PALAVRAS(g) palavras, ou NULL (ver constroi_bitset())
+    void *mapa; // imagem mapeada em memória de onde o grafo foi carregado (ver carrega_grafo_binario()), ou NULL
+    size_t tam_mapa; // tamanho da imagem mapeada
+    // adjacências no formato CSR (compressed sparse row), indexadas por vertice->id:
+    // os vizinhos de saída do vertice de id i são alvo_saida[inicio_saida[i] .. inicio_saida[i+1]-1],
+    // com pesos nas mesmas posições de peso_saida; idem para a entrada.
+    // num grafo não direcionado os vetores de entrada são os mesmos de saída
+    unsigned int *inicio_saida;
+    unsigned int *alvo_saida;
+    long int *peso_saida;
+    unsigned int *inicio_entrada;
+    unsigned int *alvo_entrada;
+    long int *peso_entrada;
+};
+//------------------------------------------------------------------------------
+//ÁREA DE TRABALHO
+//------------------------------------------------------------------------------
+// vetores auxiliares, indexados por id, de clique() e simplicial(); ficam
+// fora do grafo para que as consultas não o alterem, e são reaproveitados de
+// uma chamada para outra
+
+struct area_trabalho {
+    unsigned int *marca; // 2*capacidade marcas (ver reserva_carimbos())
+    unsigned int capacidade; // número de ids cobertos por marca
+    unsigned int carimbo; // último carimbo usado em marca
+    uint64_t *conjunto; // linha auxiliar de clique_bitset(), sempre zerada entre chamadas
+    unsigned int palavras; // tamanho de conjunto, em palavras de 64 bits
+    int padding; // só pra evitar warning
 };
 //------------------------------------------------------------------------------
 //VÉRTICE
@@ -58,17 +140,8 @@ struct grafo{
 struct vertice{
     char *nome; // nome do vertice
     unsigned int id; // id = posição do vertice no vetor de vertices do grafo, serve para facilitar a busca de vertices
-    unsigned int grau_entrada; // grau do vertice
-    unsigned int grau_saida; // grau do vertice
-    int set; //qual conjunto da bipartição o vertice pertence
-    unsigned int *rotulo; //rotulo do vertice {1..n}
-    int removido; // se for 1 a aresta do grafo foi removida, se for 0, nao
-    int tamRotulo; //tamanho do vetor de rotulos atual 
-    int passado; //se foi passado 1, senao 0
-    int visitado; //se o vertice foi visitado, muda para 1, senão permanece em 0
-    int coberto; // se o vertice esta conectado com uma aresta, muda para 1, senão permanece em zero
-    int inSet; //se o vertice ja pertence a um conjunto, muda para 1, senão permanece em zero
-    lista adjacencias_entrada;
+    int padding; // só pra evitar warning
+    lista adjacencias_entrada; // usadas só durante a construção do grafo, até congela_grafo()
     lista adjacencias_saida;
 };
 //------------------------------------------------------------------------------
@@ -80,6 +153,236 @@ typedef struct adjacencia{
 } *adjacencia;
 //------------------------------------------------------------------------------
 //CÓDIGOS
+//------------------------------------------------------------------------------
+//INSTRUMENTAÇÃO
+//------------------------------------------------------------------------------
+// campos de struct estatisticas (ver grafo.h), acumulados em estat[] com
+// somas atômicas, de forma que várias threads podem contribuir
+
+enum campo_estatistica {
+    E_LEITURAS,
+    E_LEITURAS_CGRAPH,
+    E_NS_LEITURA_TEXTO,
+    E_NS_ANALISE_DOT,
+    E_NS_MONTA_CSR,
+    E_NS_CGRAPH,
+    E_NS_COPIA_CGRAPH,
+    E_NS_ESPERA_CGRAPH,
+    E_ESCRITAS,
+    E_NS_ESCRITA,
+    E_TESTES_CORDAL,
+    E_NS_LEXBFS,
+    E_NS_VERIFICA_ELIMINACAO,
+    E_EMPARELHAMENTOS,
+    E_NS_BIPARTICAO,
+    E_NS_HOPCROFT_KARP,
+    E_NS_MONTA_EMPARELHAMENTO,
+    E_BLOCOS_ARENA,
+    E_BYTES_ARENA,
+    E_REFINAMENTOS_LEXBFS,
+    E_FASES_HOPCROFT_KARP,
+    E_EMPARELHAMENTO_GULOSO,
+    E_CAMINHOS_AUMENTANTES,
+    E_ARESTAS_PERCORRIDAS,
+    N_ESTATISTICAS
+};
+
+// nome (também usado no JSON) e posição em struct estatisticas de cada
+// campo, na ordem de enum campo_estatistica
+
+#define CAMPO(nome) { #nome, offsetof(struct estatisticas, nome) }
+
+static const struct {
+    const char *nome;
+    size_t deslocamento;
+} campos_estatisticas[N_ESTATISTICAS] = {
+    CAMPO(leituras),
+    CAMPO(leituras_cgraph),
+    CAMPO(ns_leitura_texto),
+    CAMPO(ns_analise_dot),
+    CAMPO(ns_monta_csr),
+    CAMPO(ns_cgraph),
+    CAMPO(ns_copia_cgraph),
+    CAMPO(ns_espera_cgraph),
+    CAMPO(escritas),
+    CAMPO(ns_escrita),
+    CAMPO(testes_cordal),
+    CAMPO(ns_lexbfs),
+    CAMPO(ns_verifica_eliminacao),
+    CAMPO(emparelhamentos),
+    CAMPO(ns_biparticao),
+    CAMPO(ns_hopcroft_karp),
+    CAMPO(ns_monta_emparelhamento),
+    CAMPO(blocos_arena),
+    CAMPO(bytes_arena),
+    CAMPO(refinamentos_lexbfs),
+    CAMPO(fases_hopcroft_karp),
+    CAMPO(emparelhamento_guloso),
+    CAMPO(caminhos_aumentantes),
+    CAMPO(arestas_percorridas),
+};
+
+#undef CAMPO
+
+static unsigned long long estat[N_ESTATISTICAS];
+
+// 1 se a instrumentação está ligada, 0 se não, -1 se GRAFO_ESTATISTICAS
+// ainda não foi consultada
+static int instrumentacao = -1;
+
+//------------------------------------------------------------------------------
+// devolve 1 se a instrumentação está ligada ou
+//         0 caso contrário
+//
+// na primeira chamada (se liga_estatisticas() não foi chamada antes) o
+// estado inicial é lido da variável de ambiente GRAFO_ESTATISTICAS
+
+static int instrumentado(void){
+    int ligada = __atomic_load_n(&instrumentacao, __ATOMIC_RELAXED);
+
+    if(ligada < 0){
+        const char *valor = getenv("GRAFO_ESTATISTICAS");
+        int esperado = -1;
+
+        ligada = valor && *valor && strcmp(valor, "0") != 0;
+        if(!__atomic_compare_exchange_n(&instrumentacao, &esperado, ligada, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            ligada = esperado;
+    }
+    return ligada;
+}
+
+//------------------------------------------------------------------------------
+// soma valor ao campo campo das estatísticas
+
+static void soma_estatistica(enum campo_estatistica campo, unsigned long long valor){
+    __atomic_fetch_add(&estat[campo], valor, __ATOMIC_RELAXED);
+}
+
+//------------------------------------------------------------------------------
+// marca o fim de uma fase: se medir == 1, soma ao campo campo o tempo
+// decorrido desde inicio (em ns) e devolve o instante atual, que é o início
+// da fase seguinte; se medir == 0, não faz nada e devolve 0
+//
+// com inicio == 0 só devolve o instante atual (início da primeira fase)
+
+static unsigned long long fim_fase(int medir, enum campo_estatistica campo, unsigned long long inicio){
+    if(!medir)
+        return 0;
+
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    unsigned long long agora = (unsigned long long) t.tv_sec * 1000000000ull + (unsigned long long) t.tv_nsec;
+    if(inicio)
+        soma_estatistica(campo, agora - inicio);
+    return agora;
+}
+
+//------------------------------------------------------------------------------
+
+void liga_estatisticas(int liga){
+    __atomic_store_n(&instrumentacao, liga != 0, __ATOMIC_RELAXED);
+}
+
+//------------------------------------------------------------------------------
+
+int estatisticas_ligadas(void){
+    return instrumentado();
+}
+
+//------------------------------------------------------------------------------
+
+void zera_estatisticas(void){
+    for(unsigned int i = 0; i < N_ESTATISTICAS; i++)
+        __atomic_store_n(&estat[i], 0, __ATOMIC_RELAXED);
+}
+
+//------------------------------------------------------------------------------
+
+void le_estatisticas(struct estatisticas *e){
+    if(!e)
+        return;
+
+    for(unsigned int i = 0; i < N_ESTATISTICAS; i++){
+        unsigned long long valor = __atomic_load_n(&estat[i], __ATOMIC_RELAXED);
+        memcpy((char *) e + campos_estatisticas[i].deslocamento, &valor, sizeof(valor));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int escreve_estatisticas(FILE *output){
+    if(!output)
+        return 0;
+
+    fprintf(output, "{");
+    for(unsigned int i = 0; i < N_ESTATISTICAS; i++)
+        fprintf(output, "%s\"%s\": %llu", i ? ", " : "", campos_estatisticas[i].nome,
+                __atomic_load_n(&estat[i], __ATOMIC_RELAXED));
+    fprintf(output, "}\n");
+    return !ferror(output);
+}
+
+//------------------------------------------------------------------------------
+//ARENA
+//------------------------------------------------------------------------------
+// inicia a arena a vazia; o primeiro bloco terá tam_bloco bytes (ou um
+// tamanho padrão, se tam_bloco == 0)
+
+static void inicia_arena(struct arena *a, size_t tam_bloco){
+    a->bloco = NULL;
+    a->livre = a->fim = NULL;
+    a->tam_bloco = tam_bloco ? tam_bloco : 4096;
+}
+
+//------------------------------------------------------------------------------
+// devolve tam bytes alocados na arena a, alinhados a 8 bytes, ou
+//         NULL em caso de falta de memória
+
+static void *aloca_arena(struct arena *a, size_t tam){
+    tam = (tam + 7) & ~(size_t) 7;
+
+    if(!a->bloco || (size_t) (a->fim - a->livre) < tam){
+        size_t tam_bloco = a->tam_bloco;
+        while(tam_bloco < tam)
+            tam_bloco *= 2;
+
+        // o cabeçalho ocupa 16 bytes, o que mantém os dados alinhados
+        struct bloco_arena *b = malloc(sizeof(struct bloco_arena) + tam_bloco);
+        if(!b)
+            return NULL;
+        b->anterior = a->bloco;
+        b->tamanho = tam_bloco;
+        a->bloco = b;
+        a->livre = (char *) (b + 1);
+        a->fim = a->livre + tam_bloco;
+        a->tam_bloco = 2 * tam_bloco;
+        if(instrumentado()){
+            soma_estatistica(E_BLOCOS_ARENA, 1);
+            soma_estatistica(E_BYTES_ARENA, tam_bloco);
+        }
+    }
+
+    void *p = a->livre;
+    a->livre += tam;
+    return p;
+}
+
+//------------------------------------------------------------------------------
+// desaloca todos os blocos da arena a, que fica vazia
+
+static void libera_arena(struct arena *a){
+    struct bloco_arena *b = a->bloco;
+
+    while(b){
+        struct bloco_arena *anterior = b->anterior;
+        free(b);
+        b = anterior;
+    }
+    a->bloco = NULL;
+    a->livre = a->fim = NULL;
+}
+
 //------------------------------------------------------------------------------
 //LISTA
 //------------------------------------------------------------------------------
@@ -109,19 +412,49 @@ no proximo_no(no n) { return n->proximo; }
 //---------------------------------------------------------------------------
 // cria uma lista vazia e a devolve
 //
+// a lista e seus nós são alocados numa arena própria, que começa com espaço
+// para alguns nós; assim uma lista pequena custa uma única alocação
+//
 // devolve NULL em caso de falha
 
 lista constroi_lista(void) {
-    lista l = malloc(sizeof(struct lista));
+    struct arena a;
+
+    inicia_arena(&a, sizeof(struct lista) + 14 * sizeof(struct no));
+
+    lista l = aloca_arena(&a, sizeof(struct lista));
+
+    if(!l) 
+        return NULL;
+
+    l->primeiro = NULL;
+    l->tamanho = 0;
+    l->livres = NULL;
+    l->propria = a;
+    l->arena = &l->propria;
+
+    return l;
+}
+
+//---------------------------------------------------------------------------
+// cria uma lista vazia alocada (ela e seus nós) na arena a, que é quem a
+// desaloca
+//
+// devolve NULL em caso de falha
+
+static lista constroi_lista_arena(struct arena *a) {
+    lista l = aloca_arena(a, sizeof(struct lista));
 
     if(!l) 
         return NULL;
 
     l->primeiro = NULL;
     l->tamanho = 0;
+    l->livres = NULL;
+    inicia_arena(&l->propria, 0);
+    l->arena = a;
 
     return l;
-    free(l);
 }
 //---------------------------------------------------------------------------
 // desaloca a lista l e todos os seus nós
@@ -136,18 +469,17 @@ lista constroi_lista(void) {
 //      ou 0 em caso de falha
 
 int destroi_lista(lista l, int destroi(void *)) { 
-    no p;
     int ok=1;
 
-    while ((p = primeiro_no(l))) {
-        l->primeiro = proximo_no(p);
-        if(destroi)
+    if(destroi)
+        for (no p = primeiro_no(l); p; p = proximo_no(p))
             ok &= destroi(conteudo(p));
 
-        free(p);
+    if(l->arena == &l->propria){
+        // a lista está dentro da sua própria arena
+        struct arena a = l->propria;
+        libera_arena(&a);
     }
-
-    free(l);
     return ok;
 }
 //---------------------------------------------------------------------------
@@ -157,7 +489,12 @@ int destroi_lista(lista l, int destroi(void *)) {
 //      ou NULL em caso de falha
 
 no insere_lista(void *conteudo, lista l) { 
-    no novo = malloc(sizeof(struct no));
+    no novo = l->livres;
+
+    if(novo)
+        l->livres = novo->proximo;
+    else
+        novo = aloca_arena(l->arena, sizeof(struct no));
 
     if(!novo) 
         return NULL;
@@ -167,7 +504,6 @@ no insere_lista(void *conteudo, lista l) {
     ++l->tamanho;
   
     return l->primeiro = novo;
-    free(novo);
 }
 
 //------------------------------------------------------------------------------
@@ -175,6 +511,8 @@ no insere_lista(void *conteudo, lista l) {
 // se destroi != NULL, executa destroi(conteudo(rno)) 
 // devolve 1, em caso de sucesso
 //         0, se rno não for um no de l
+//
+// o nó removido volta para a lista de nós livres de l
 
 int remove_no(struct lista *l, struct no *rno, int destroi(void *)) {
 	int r = 1;
@@ -185,18 +523,20 @@ int remove_no(struct lista *l, struct no *rno, int destroi(void *)) {
 			r = destroi(conteudo(rno));
 		}
 		
-        free(rno);
+        rno->proximo = l->livres;
+        l->livres = rno;
 		l->tamanho--;
 		return r;
 	}
 	
-    for (no n = primeiro_no(l); n->proximo; n = proximo_no(n)) {
+    for (no n = primeiro_no(l); n && n->proximo; n = proximo_no(n)) {
 		if (n->proximo == rno) {
 			n->proximo = rno->proximo;
 			if (destroi != NULL) {
 				r = destroi(conteudo(rno));
 			}
-			free(rno);
+			rno->proximo = l->livres;
+			l->livres = rno;
 			l->tamanho--;
 			return r;
 		}
@@ -207,6 +547,32 @@ int remove_no(struct lista *l, struct no *rno, int destroi(void *)) {
 //------------------------------------------------------------------------------
 //GRAFO E VERTICE
 //------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// devolve o hash (FNV-1a) do nome de um vertice
+
+static unsigned int hash_nome(const char *nome){
+    unsigned int h = 2166136261u;
+
+    for(const unsigned char *c = (const unsigned char *) nome; *c; c++){
+        h ^= *c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+//------------------------------------------------------------------------------
+// devolve o tamanho da tabela hash para um grafo com total_vertices vertices:
+// a menor potência de 2 maior ou igual ao dobro do número de vertices, para
+// que a tabela fique no máximo meio cheia
+
+static unsigned int tamanho_indice(unsigned int total_vertices){
+    unsigned int tam = 16;
+
+    while(tam < 2 * total_vertices)
+        tam <<= 1;
+    return tam;
+}
+
 //------------------------------------------------------------------------------
 // cria e devolve um  grafo g
  
@@ -216,25 +582,40 @@ static grafo cria_grafo(const char *nome, int direcionado, int ponderado, int to
     if(g == NULL)
     return 0;
    
-    g->nome = malloc((strlen(nome) + 1) * sizeof(char));
+    // vertices e nomes ficam na arena do grafo, que já começa com espaço
+    // para total_vertices deles
+    inicia_arena(&g->memoria, (total_vertices > 0 ? (size_t) total_vertices : 1) * (sizeof(struct vertice) + 16) + strlen(nome) + 1);
+    inicia_arena(&g->construcao, 0);
+    g->nome = aloca_arena(&g->memoria, strlen(nome) + 1);
     strcpy(g->nome, nome);
     g->direcionado = direcionado;
     g->ponderado = ponderado;
     g->n_vertices = 0;
     g->n_arestas = 0;
-    g->vertices = malloc((unsigned int)total_vertices* sizeof(vertice));
+    g->capacidade = total_vertices > 0 ? (unsigned int) total_vertices : 1;
+    g->vertices = malloc(g->capacidade * sizeof(vertice));
+    g->tam_indice = tamanho_indice((unsigned int) total_vertices);
+    g->indice = calloc(g->tam_indice, sizeof(unsigned int));
+    g->congelado = 0;
+    g->inicio_saida = g->alvo_saida = NULL;
+    g->peso_saida = NULL;
+    g->inicio_entrada = g->alvo_entrada = NULL;
+    g->peso_entrada = NULL;
+    g->bits = NULL;
+    g->mapa = NULL;
+    g->tam_mapa = 0;
  
     return g;
-    free(g->nome);
-    free(g);
 }
  
 //------------------------------------------------------------------------------
 // cria um vizinho e insere na lista de vizinhos do vertice de origem e/ou na de destino tambem
 // se ele nao for direcionado
+//
+// os vizinhos e os nós das listas ficam na arena de construção do grafo
  
 static void cria_vizinhanca(grafo g, vertice origem, vertice destino, long int peso){
-    adjacencia viz_1 = malloc(sizeof(struct adjacencia));
+    adjacencia viz_1 = aloca_arena(&g->construcao, sizeof(struct adjacencia));
    
     if(viz_1 == NULL)
         printf("Sem memoria");
@@ -243,14 +624,12 @@ static void cria_vizinhanca(grafo g, vertice origem, vertice destino, long int p
         viz_1->v_origem = origem;
         viz_1->v_destino = destino;
 	    insere_lista(viz_1, origem->adjacencias_saida);
-        origem->grau_saida++;
-        destino->grau_entrada++;
  
         if (!direcionado(g)) {
             // se o grafo não for direcionado, a aresta deve aparecer também na
             // lista de adjacencia do vertice dest
  
-            adjacencia viz_2 = malloc(sizeof(struct adjacencia));
+            adjacencia viz_2 = aloca_arena(&g->construcao, sizeof(struct adjacencia));
             if(viz_2 == NULL)
                 printf("Sem memoria");
             else{
@@ -258,12 +637,10 @@ static void cria_vizinhanca(grafo g, vertice origem, vertice destino, long int p
                 viz_2->v_origem = destino;
                 viz_2->v_destino = origem;
                 insere_lista(viz_2, destino->adjacencias_saida);
-                destino->grau_saida++;
-                origem->grau_entrada++;
             }
         }
         else{
-            adjacencia viz_3 = malloc(sizeof(struct adjacencia));
+            adjacencia viz_3 = aloca_arena(&g->construcao, sizeof(struct adjacencia));
             if(viz_3 == NULL)
                 printf("Sem memoria");
             else{
@@ -279,62 +656,87 @@ static void cria_vizinhanca(grafo g, vertice origem, vertice destino, long int p
 }
  
 //------------------------------------------------------------------------------
-// destroi um vizinho
+// insere o vertice v na tabela hash de g, por sondagem linear
+
+static void indexa_vertice(grafo g, vertice v){
+    unsigned int mascara = g->tam_indice - 1;
+    unsigned int i = hash_nome(v->nome) & mascara;
+
+    while(g->indice[i] != 0)
+        i = (i + 1) & mascara;
+    g->indice[i] = v->id + 1;
+}
  
-static int destroi_vizinho(adjacencia v){
-    free(v);
+//------------------------------------------------------------------------------
+// dobra a capacidade do vetor de vertices de g e, se necessário, refaz a
+// tabela hash com o dobro do tamanho para mantê-la no máximo meio cheia
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int aumenta_capacidade(grafo g){
+    vertice *vertices = realloc(g->vertices, 2 * g->capacidade * sizeof(vertice));
+
+    if(!vertices)
+        return 0;
+    g->vertices = vertices;
+    g->capacidade *= 2;
+
+    unsigned int tam = tamanho_indice(g->capacidade);
+    if(tam > g->tam_indice){
+        unsigned int *indice = calloc(tam, sizeof(unsigned int));
+        if(!indice)
+            return 0;
+        free(g->indice);
+        g->indice = indice;
+        g->tam_indice = tam;
+        for(unsigned int i = 0; i < g->n_vertices; i++)
+            indexa_vertice(g, g->vertices[i]);
+    }
     return 1;
 }
  
 //------------------------------------------------------------------------------
 // cria, insere no grafo e retorna o vertice
 static vertice cria_vertice(grafo g, const char *nome){
-    vertice v = malloc(sizeof(struct vertice));
+    if(g->n_vertices == g->capacidade && !aumenta_capacidade(g))
+        return NULL;
+
+    vertice v = aloca_arena(&g->memoria, sizeof(struct vertice));
  
     if(v == NULL){
         return 0;
     }else{
         v->id = g->n_vertices;
-        v->nome = malloc((strlen(nome) +1) *sizeof(char));
+        v->nome = aloca_arena(&g->memoria, strlen(nome) + 1);
         strcpy(v->nome, nome);
-        v->adjacencias_saida = constroi_lista();
-        v->adjacencias_entrada = constroi_lista();
-        v->grau_entrada = 0;
-        v->grau_saida = 0;
-        v->removido = 0;
-        v->visitado = 0;
-        v->coberto = 0;
-        v->rotulo = NULL;
-        v->inSet = 0;
+        v->adjacencias_saida = constroi_lista_arena(&g->construcao);
+        v->adjacencias_entrada = constroi_lista_arena(&g->construcao);
         g->vertices[v->id] = v;
         g->n_vertices++;
+        indexa_vertice(g, v);
 
     }
  
     return v;
-    free(v->nome);
-    free(v);
-}
- 
-//------------------------------------------------------------------------------
-// destroi um vertice
-static void destroi_vertice(vertice v){
-    destroi_lista(v->adjacencias_saida, (int (*)(void *)) destroi_vizinho);
-    destroi_lista(v->adjacencias_entrada, (int (*)(void *)) destroi_vizinho);
-    v->grau_saida = 0;
-    v->grau_entrada = 0;
-    free(v->nome);
-    free(v);
-    v =  NULL;
 }
  
 //------------------------------------------------------------------------------
-// busca um vertice pelo nome do grafo
+// devolve o vertice de nome nome no grafo g, ou
+//         NULL, se g não tem vertice com esse nome
+//
+// a busca é feita na tabela hash de g, em tempo esperado constante
  
-static vertice v_busca(grafo g, char *nome){
-    for(unsigned int i = 0; i < g->n_vertices; i++){
-        if(strcmp(g->vertices[i]->nome, nome) == 0)
-            return g->vertices[i];
+vertice busca_vertice(const char *nome, grafo g){
+    if(!g || !nome)
+        return NULL;
+
+    unsigned int mascara = g->tam_indice - 1;
+
+    for(unsigned int i = hash_nome(nome) & mascara; g->indice[i] != 0; i = (i + 1) & mascara){
+        vertice v = g->vertices[g->indice[i] - 1];
+        if(strcmp(v->nome, nome) == 0)
+            return v;
     }
     return NULL;
 }
@@ -371,835 +773,4855 @@ static int contem_pesos(Agraph_t *Ag) {
 }
  
 //------------------------------------------------------------------------------
-// devolve o nome do grafo g
- 
-char *nome_grafo(grafo g){
-    char nome_g[1];
-    nome_g[0] = '\0';
-    return g ? g->nome : nome_g;
-}
- 
-//------------------------------------------------------------------------------
-// devolve 1, se g é direcionado, ou
-//         0, caso contrário
- 
-int direcionado(grafo g){
-    return g ? g->direcionado : 0;
-}
- 
-//------------------------------------------------------------------------------
-// devolve 1, se g tem pesos nas arestas/arcos,
-//      ou 0, caso contrário
- 
-int ponderado(grafo g){
-    return g ? g->ponderado : 0;
-}
- 
-//------------------------------------------------------------------------------
-// devolve o número de vértices do grafo g
- 
-unsigned int n_vertices(grafo g){
-    return g ? g->n_vertices : 0;
-}
- 
-//------------------------------------------------------------------------------
-// devolve o número de arestas/arcos do grafo g
- 
-unsigned int n_arestas(grafo g){
-    return g ? g->n_arestas : 0;
-}
- 
-//------------------------------------------------------------------------------
-// devolve o nome do vertice v
- 
-char *nome_vertice(vertice v){
-    char nome_v[1];
-    nome_v[0] = '\0';
-    return v ? v->nome : nome_v;
-}
- 
-//------------------------------------------------------------------------------
-// lê um grafo no formato dot de input, usando as rotinas de libcgraph
-//
-// desconsidera todos os atributos do grafo lido exceto o atributo
-// "peso" quando ocorrer; neste caso o valor do atributo é o peso da
-// aresta/arco que é um long int
-//
-// num grafo com pesos todas as arestas/arcos tem peso
-//
-// o peso default de uma aresta num grafo com pesos é 0
+// converte as listas de adjacência (de saída se entrada == 0, de entrada se
+// entrada == 1) dos vertices de g para o formato CSR
 //
-// todas as estruturas de dados alocadas pela libcgraph são
-// desalocadas ao final da execução
+// a ordem dos vizinhos de cada vertice é a mesma da lista de adjacência
 //
-// devolve o grafo lido ou
-//         NULL em caso de erro
- 
-grafo le_grafo(FILE *input){
-    if (!input)
-        return NULL;
-   
-    Agraph_t *Ag = agread(input, NULL);
-   
-    if(!Ag)
-        return NULL;
- 
-    grafo g = cria_grafo(agnameof(Ag), agisdirected(Ag), contem_pesos(Ag), agnnodes(Ag));
- 
-    for (Agnode_t *Av=agfstnode(Ag); Av; Av=agnxtnode(Ag,Av)) {
-            cria_vertice(g, agnameof(Av));
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int constroi_csr(grafo g, int entrada, unsigned int **inicio, unsigned int **alvo, long int **peso){
+    unsigned int total = 0;
+
+    *inicio = malloc((g->n_vertices + 1) * sizeof(unsigned int));
+    if(!*inicio)
+        return 0;
+
+    for(unsigned int i = 0; i < g->n_vertices; i++){
+        (*inicio)[i] = total;
+        total += tamanho_lista(entrada ? g->vertices[i]->adjacencias_entrada : g->vertices[i]->adjacencias_saida);
     }
- 
-    for (Agnode_t *Av=agfstnode(Ag); Av; Av=agnxtnode(Ag,Av)) {
-        for (Agedge_t *Ae=agfstout(Ag,Av); Ae; Ae=agnxtout(Ag,Ae)) {
-            vertice u = v_busca(g, agnameof(agtail(Ae)));
-            vertice v = v_busca(g, agnameof(aghead(Ae)));
-            cria_vizinhanca(g, u, v, get_peso(Ae));
+    (*inicio)[g->n_vertices] = total;
+
+    *alvo = malloc((total ? total : 1) * sizeof(unsigned int));
+    *peso = malloc((total ? total : 1) * sizeof(long int));
+    if(!*alvo || !*peso){
+        free(*inicio);
+        free(*alvo);
+        free(*peso);
+        return 0;
+    }
+
+    for(unsigned int i = 0; i < g->n_vertices; i++){
+        unsigned int k = (*inicio)[i];
+        lista l = entrada ? g->vertices[i]->adjacencias_entrada : g->vertices[i]->adjacencias_saida;
+
+        for(no n = primeiro_no(l); n != NULL; n = proximo_no(n)){
+            adjacencia a = conteudo(n);
+            (*alvo)[k] = entrada ? a->v_origem->id : a->v_destino->id;
+            (*peso)[k] = a->peso;
+            k++;
         }
     }
-   
-    agclose(Ag);
-    agfree(Ag, NULL);
-    return g;
-}  
- 
+    return 1;
+}
+
 //------------------------------------------------------------------------------
-// desaloca toda a memória usada em *g
+// congela o grafo g: converte suas listas de adjacência para vetores
+// contíguos no formato CSR e desaloca as listas
+//
+// depois de congelado o grafo não recebe mais arestas/arcos
 //
 // devolve 1 em caso de sucesso ou
 //         0 caso contrário
-//
-// g é um (void *) para que destroi_grafo() possa ser usada como argumento de
-// destroi_lista()
- 
-int destroi_grafo(void *g){
-    if (!g)
-		return 0;
- 
-    for (unsigned int i=0; i<((grafo) g)->n_vertices; i++)
-        destroi_vertice(((grafo) g)->vertices[i]);
+
+int congela_grafo(grafo g){
+    if(!g)
+        return 0;
+    if(g->congelado)
+        return 1;
+
+    if(!constroi_csr(g, 0, &g->inicio_saida, &g->alvo_saida, &g->peso_saida))
+        return 0;
+
+    if(g->direcionado){
+        if(!constroi_csr(g, 1, &g->inicio_entrada, &g->alvo_entrada, &g->peso_entrada)){
+            free(g->inicio_saida);
+            free(g->alvo_saida);
+            free(g->peso_saida);
+            return 0;
+        }
+    }
+    else{
+        g->inicio_entrada = g->inicio_saida;
+        g->alvo_entrada = g->alvo_saida;
+        g->peso_entrada = g->peso_saida;
+    }
+
+    for(unsigned int i = 0; i < g->n_vertices; i++)
+        g->vertices[i]->adjacencias_saida = g->vertices[i]->adjacencias_entrada = NULL;
+    libera_arena(&g->construcao);
+
+    g->congelado = 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// monta diretamente os vetores CSR de g a partir de m arestas/arcos dados
+// por origem[k], destino[k] e peso[k] (ids dos vertices de g)
+//
+// o resultado é o mesmo que se obteria inserindo as arestas na ordem dada
+// com cria_vizinhanca() e depois chamando congela_grafo()
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int monta_csr(grafo g, unsigned int m, const unsigned int *origem, const unsigned int *destino, const long int *peso){
+    unsigned int n = g->n_vertices;
+    unsigned int total = g->direcionado ? m : 2 * m;
+
+    g->inicio_saida = calloc(n + 1, sizeof(unsigned int));
+    g->alvo_saida = malloc((total ? total : 1) * sizeof(unsigned int));
+    g->peso_saida = malloc((total ? total : 1) * sizeof(long int));
+    if(g->direcionado){
+        g->inicio_entrada = calloc(n + 1, sizeof(unsigned int));
+        g->alvo_entrada = malloc((m ? m : 1) * sizeof(unsigned int));
+        g->peso_entrada = malloc((m ? m : 1) * sizeof(long int));
+    }
+    else{
+        g->inicio_entrada = g->inicio_saida;
+        g->alvo_entrada = g->alvo_saida;
+        g->peso_entrada = g->peso_saida;
+    }
+    if(!g->inicio_saida || !g->alvo_saida || !g->peso_saida
+       || !g->inicio_entrada || !g->alvo_entrada || !g->peso_entrada)
+        return 0;
+
+    // inicio[i+1] conta os vizinhos de i; depois da soma de prefixos,
+    // inicio[i+1] é o fim do intervalo de i, que é preenchido de trás para
+    // a frente para reproduzir a ordem das listas (inserção no início)
+    for(unsigned int k = 0; k < m; k++){
+        g->inicio_saida[origem[k] + 1]++;
+        g->inicio_entrada[destino[k] + 1]++;
+    }
+    for(unsigned int i = 0; i < n; i++){
+        g->inicio_saida[i + 1] += g->inicio_saida[i];
+        if(g->direcionado)
+            g->inicio_entrada[i + 1] += g->inicio_entrada[i];
+    }
+
+    unsigned int *pos_saida = malloc((n ? n : 1) * sizeof(unsigned int));
+    unsigned int *pos_entrada = g->direcionado ? malloc((n ? n : 1) * sizeof(unsigned int)) : pos_saida;
+    if(!pos_saida || !pos_entrada){
+        free(pos_saida);
+        if(g->direcionado)
+            free(pos_entrada);
+        return 0;
+    }
+    memcpy(pos_saida, g->inicio_saida + 1, n * sizeof(unsigned int));
+    if(g->direcionado)
+        memcpy(pos_entrada, g->inicio_entrada + 1, n * sizeof(unsigned int));
+
+    for(unsigned int k = 0; k < m; k++){
+        unsigned int j = --pos_saida[origem[k]];
+        g->alvo_saida[j] = destino[k];
+        g->peso_saida[j] = peso[k];
+
+        j = --pos_entrada[destino[k]];
+        g->alvo_entrada[j] = origem[k];
+        g->peso_entrada[j] = peso[k];
+    }
+
+    free(pos_saida);
+    if(g->direcionado)
+        free(pos_entrada);
+
+    for(unsigned int i = 0; i < n; i++)
+        g->vertices[i]->adjacencias_saida = g->vertices[i]->adjacencias_entrada = NULL;
+    libera_arena(&g->construcao);
+    g->n_arestas = m;
+    g->congelado = 1;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve um grafo de nome nome com n vertices, de nomes "0", "1", ...,
+// "n-1" (na ordem dos ids), e com as m arestas/arcos de origem[k] para
+// destino[k], de peso peso[k] (o grafo só é ponderado se peso != NULL), ou
+//         NULL em caso de erro
+//
+// as arestas são montadas diretamente em CSR, sem passar pelas listas de
+// adjacência; o grafo é o mesmo que le_grafo() devolveria para um arquivo
+// dot que declarasse os vertices em ordem e depois as arestas/arcos, se as
+// arestas estiverem ordenadas pela origem
+
+grafo constroi_grafo(const char *nome, int direcionado, unsigned int n, unsigned int m,
+                     const unsigned int *origem, const unsigned int *destino, const long int *peso){
+    if(!nome || n > INT_MAX || (m > 0 && (!origem || !destino)) || (!direcionado && m > UINT_MAX / 2))
+        return NULL;
+    for(unsigned int k = 0; k < m; k++)
+        if(origem[k] >= n || destino[k] >= n)
+            return NULL;
+
+    grafo g = cria_grafo(nome, direcionado, peso != NULL, (int) n);
+    long int *zeros = peso ? NULL : calloc(m ? m : 1, sizeof(long int));
+    char id[16];
+    int ok = g && g->vertices && g->indice && (peso || zeros);
+
+    for(unsigned int i = 0; ok && i < n; i++){
+        snprintf(id, sizeof(id), "%u", i);
+        ok = cria_vertice(g, id) != NULL;
+    }
+    if(ok)
+        ok = monta_csr(g, m, origem, destino, peso ? peso : zeros);
+    free(zeros);
+    if(!ok){
+        if(g)
+            destroi_grafo(g);
+        return NULL;
+    }
+    return g;
+}
+
+//------------------------------------------------------------------------------
+//LEITURA DO FORMATO DOT
+//------------------------------------------------------------------------------
+// leitor próprio para o subconjunto do formato dot usado nos arquivos de
+// dot/: grafos (di)grafos, estritos ou não, declarações de vertices, de
+// arestas/arcos (inclusive em cadeia, a -- b -- c), listas de atributos,
+// atribuições de atributos do grafo e comentários
+//
+// o leitor constrói o grafo em uma única passada sobre o texto, sem passar
+// pela libcgraph; qualquer construção fora desse subconjunto (subgrafos,
+// portas, strings HTML, concatenação de strings) faz a leitura falhar para
+// que le_grafo() recorra à libcgraph
+
+//------------------------------------------------------------------------------
+// tipos de token do leitor dot
+
+enum token_dot {
+    T_FIM,
+    T_ID,
+    T_ABRE_CHAVE,
+    T_FECHA_CHAVE,
+    T_ABRE_COLCHETE,
+    T_FECHA_COLCHETE,
+    T_PONTO_VIRGULA,
+    T_VIRGULA,
+    T_IGUAL,
+    T_ARESTA, // --
+    T_ARCO, // ->
+    T_INVALIDO // token inválido ou fora do subconjunto suportado
+};
+
+//------------------------------------------------------------------------------
+// estado do leitor dot
+
+struct leitor_dot {
+    const char *p; // próximo caractere a ser lido
+    const char *fim; // fim do texto
+    const char *inicio; // início do texto
+    char *texto; // conteúdo do último T_ID lido, terminado em '\0'
+    size_t tam_texto; // tamanho alocado de texto
+    int aspas; // 1, se o último T_ID estava entre aspas, 0 se não
+    int padding; // só pra evitar warning
+};
+
+//------------------------------------------------------------------------------
+// arestas/arcos lidos, na ordem em que foram criados
+//
+// num grafo estrito, tabela é uma tabela hash (par de ids) -> índice+1 da
+// aresta, usada para não repetir arestas
+
+struct arestas_dot {
+    unsigned int *origem;
+    unsigned int *destino;
+    long int *peso;
+    unsigned int n;
+    unsigned int capacidade;
+    unsigned int *tabela;
+    unsigned int tam_tabela;
+    int padding; // só pra evitar warning
+};
+
+//------------------------------------------------------------------------------
+// devolve 1, se c pode fazer parte de um identificador dot sem aspas, ou
+//         0, caso contrário
+
+static int caractere_id(int c){
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+        || (c >= '0' && c <= '9') || c >= 128;
+}
+
+//------------------------------------------------------------------------------
+// acrescenta o caractere c na posição i do texto do leitor l
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int acrescenta_texto(struct leitor_dot *l, size_t i, char c){
+    if(i + 1 >= l->tam_texto){
+        size_t tam = l->tam_texto ? 2 * l->tam_texto : 64;
+        char *texto = realloc(l->texto, tam);
+        if(!texto)
+            return 0;
+        l->texto = texto;
+        l->tam_texto = tam;
+    }
+    l->texto[i] = c;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// pula espaços em branco e comentários (/* */, // e linhas iniciadas por #)
+//
+// como na libcgraph, # só inicia um comentário na primeira coluna: no início
+// do texto ou logo depois de um '\n'
+
+static void pula_brancos(struct leitor_dot *l){
+    while(l->p < l->fim){
+        char c = *l->p;
+
+        if(c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v')
+            l->p++;
+        else if(c == '#' && (l->p == l->inicio || l->p[-1] == '\n')){
+            while(l->p < l->fim && *l->p != '\n')
+                l->p++;
+        }
+        else if(c == '/' && l->p + 1 < l->fim && l->p[1] == '/'){
+            while(l->p < l->fim && *l->p != '\n')
+                l->p++;
+        }
+        else if(c == '/' && l->p + 1 < l->fim && l->p[1] == '*'){
+            l->p += 2;
+            while(l->p + 1 < l->fim && !(l->p[0] == '*' && l->p[1] == '/'))
+                l->p++;
+            l->p = l->p + 1 < l->fim ? l->p + 2 : l->fim;
+        }
+        else
+            return;
+    }
+}
+
+//------------------------------------------------------------------------------
+// lê e devolve o próximo token do texto
+//
+// identificadores, números e strings entre aspas são devolvidos como T_ID,
+// com o conteúdo em l->texto
+
+static enum token_dot proximo_token(struct leitor_dot *l){
+    size_t i = 0;
+
+    pula_brancos(l);
+    if(l->p == l->fim)
+        return T_FIM;
+
+    char c = *l->p++;
+    l->aspas = 0;
+
+    switch(c){
+    case '{': return T_ABRE_CHAVE;
+    case '}': return T_FECHA_CHAVE;
+    case '[': return T_ABRE_COLCHETE;
+    case ']': return T_FECHA_COLCHETE;
+    case ';': return T_PONTO_VIRGULA;
+    case ',': return T_VIRGULA;
+    case '=': return T_IGUAL;
+    case '"':
+        l->aspas = 1;
+        while(l->p < l->fim && *l->p != '"'){
+            if(*l->p == '\\' && l->p + 1 < l->fim){
+                if(l->p[1] == '"'){
+                    l->p++;
+                }
+                else if(l->p[1] == '\n'){
+                    l->p += 2;
+                    continue;
+                }
+                else if(l->p[1] == '\r' && l->p + 2 < l->fim && l->p[2] == '\n'){
+                    l->p += 3;
+                    continue;
+                }
+            }
+            if(!acrescenta_texto(l, i++, *l->p++))
+                return T_INVALIDO;
+        }
+        if(l->p == l->fim)
+            return T_INVALIDO;
+        l->p++;
+        // concatenação de strings ("a" + "b") não é suportada
+        pula_brancos(l);
+        if(l->p < l->fim && *l->p == '+')
+            return T_INVALIDO;
+        break;
+    case '-':
+        if(l->p < l->fim && *l->p == '-'){
+            l->p++;
+            return T_ARESTA;
+        }
+        if(l->p < l->fim && *l->p == '>'){
+            l->p++;
+            return T_ARCO;
+        }
+        // número negativo
+        if(l->p == l->fim || !((*l->p >= '0' && *l->p <= '9') || *l->p == '.'))
+            return T_INVALIDO;
+        if(!acrescenta_texto(l, i++, c))
+            return T_INVALIDO;
+        c = *l->p++;
+        // fallthrough
+    default:
+        if((c >= '0' && c <= '9') || c == '.'){
+            int ponto = 0;
+            for(;;){
+                if(c == '.'){
+                    if(ponto)
+                        return T_INVALIDO;
+                    ponto = 1;
+                }
+                else if(c < '0' || c > '9')
+                    return T_INVALIDO;
+                if(!acrescenta_texto(l, i++, c))
+                    return T_INVALIDO;
+                if(l->p == l->fim || !(*l->p == '.' || (*l->p >= '0' && *l->p <= '9')))
+                    break;
+                c = *l->p++;
+            }
+            // número colado a um identificador (ex.: 2abc) é ambíguo
+            if(l->p < l->fim && caractere_id((unsigned char) *l->p))
+                return T_INVALIDO;
+        }
+        else if(caractere_id((unsigned char) c)){
+            if(!acrescenta_texto(l, i++, c))
+                return T_INVALIDO;
+            while(l->p < l->fim && caractere_id((unsigned char) *l->p))
+                if(!acrescenta_texto(l, i++, *l->p++))
+                    return T_INVALIDO;
+        }
+        else
+            return T_INVALIDO;
+    }
+
+    if(!acrescenta_texto(l, i, '\0'))
+        return T_INVALIDO;
+    return T_ID;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se o último T_ID lido é a palavra reservada p (sem distinção
+//            entre maiúsculas e minúsculas, e só se não estava entre aspas), ou
+//         0, caso contrário
+
+static int palavra_reservada(struct leitor_dot *l, const char *p){
+    if(l->aspas)
+        return 0;
+
+    const char *c = l->texto;
+    for(; *c && *p; c++, p++){
+        char minuscula = (*c >= 'A' && *c <= 'Z') ? (char) (*c - 'A' + 'a') : *c;
+        if(minuscula != *p)
+            return 0;
+    }
+    return *c == *p;
+}
+
+//------------------------------------------------------------------------------
+// lê uma ou mais listas de atributos [a=b, c=d; ...] a partir do token *t
+// (que deve ser T_ABRE_COLCHETE) e deixa em *t o token seguinte
+//
+// se o atributo "peso" ocorrer, seu valor é devolvido em *peso e *tem_peso
+// recebe 1
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de erro
+
+static int le_atributos(struct leitor_dot *l, enum token_dot *t, long int *peso, int *tem_peso){
+    while(*t == T_ABRE_COLCHETE){
+        *t = proximo_token(l);
+        while(*t != T_FECHA_COLCHETE){
+            if(*t != T_ID)
+                return 0;
+
+            int eh_peso = strcmp(l->texto, "peso") == 0;
+
+            *t = proximo_token(l);
+            if(*t == T_IGUAL){
+                if(proximo_token(l) != T_ID)
+                    return 0;
+                if(eh_peso){
+                    *peso = atol(l->texto);
+                    *tem_peso = 1;
+                }
+                *t = proximo_token(l);
+            }
+            if(*t == T_VIRGULA || *t == T_PONTO_VIRGULA)
+                *t = proximo_token(l);
+        }
+        *t = proximo_token(l);
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve o vertice de nome nome em g, criando-o se ainda não existir
+
+static vertice obtem_vertice(grafo g, const char *nome){
+    vertice v = busca_vertice(nome, g);
+
+    return v ? v : cria_vertice(g, nome);
+}
+
+//------------------------------------------------------------------------------
+// devolve a posição da tabela de a onde está (ou deveria estar) a aresta
+// de u para v; num grafo não direcionado {u,v} e {v,u} são a mesma aresta
+
+static unsigned int posicao_aresta(struct arestas_dot *a, int direcionado, unsigned int u, unsigned int v){
+    if(!direcionado && v < u){
+        unsigned int t = u;
+        u = v;
+        v = t;
+    }
+
+    unsigned int mascara = a->tam_tabela - 1;
+    unsigned int i = (u * 2654435761u ^ v * 2246822519u) & mascara;
+
+    while(a->tabela[i] != 0){
+        unsigned int k = a->tabela[i] - 1;
+        unsigned int x = a->origem[k], y = a->destino[k];
+
+        if(!direcionado && y < x){
+            unsigned int t = x;
+            x = y;
+            y = t;
+        }
+        if(x == u && y == v)
+            break;
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+// insere em a a aresta/arco de u para v com peso peso
+//
+// num grafo estrito, se a aresta já existe ela não é repetida; neste caso
+// o peso só é atualizado se tem_peso == 1, como faz a libcgraph
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int insere_aresta_dot(struct arestas_dot *a, int direcionado, int estrito,
+                             unsigned int u, unsigned int v, long int peso, int tem_peso){
+    if(estrito && a->tam_tabela > 0){
+        unsigned int i = posicao_aresta(a, direcionado, u, v);
+        if(a->tabela[i] != 0){
+            if(tem_peso)
+                a->peso[a->tabela[i] - 1] = peso;
+            return 1;
+        }
+    }
+
+    if(a->n == a->capacidade){
+        unsigned int capacidade = a->capacidade ? 2 * a->capacidade : 1024;
+        unsigned int *origem = realloc(a->origem, capacidade * sizeof(unsigned int));
+        if(origem)
+            a->origem = origem;
+        unsigned int *destino = realloc(a->destino, capacidade * sizeof(unsigned int));
+        if(destino)
+            a->destino = destino;
+        long int *pesos = realloc(a->peso, capacidade * sizeof(long int));
+        if(pesos)
+            a->peso = pesos;
+        if(!origem || !destino || !pesos)
+            return 0;
+        a->capacidade = capacidade;
+    }
+
+    a->origem[a->n] = u;
+    a->destino[a->n] = v;
+    a->peso[a->n] = peso;
+    a->n++;
+
+    if(estrito){
+        if(2 * a->n > a->tam_tabela){
+            unsigned int tam = a->tam_tabela ? 2 * a->tam_tabela : 2048;
+            unsigned int *tabela = calloc(tam, sizeof(unsigned int));
+            if(!tabela)
+                return 0;
+            free(a->tabela);
+            a->tabela = tabela;
+            a->tam_tabela = tam;
+            for(unsigned int k = 0; k < a->n; k++)
+                a->tabela[posicao_aresta(a, direcionado, a->origem[k], a->destino[k])] = k + 1;
+        }
+        else
+            a->tabela[posicao_aresta(a, direcionado, u, v)] = a->n;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// extremidades de um comando de arestas/arcos a -- { b c } -- d
+//
+// cada extremidade é um grupo de vertices: um único vertice ou os vertices
+// de um subgrafo anônimo; os ids do grupo k são
+// id[inicio[k] .. inicio[k+1]-1]
+
+struct cadeia_dot {
+    unsigned int *id;
+    unsigned int n_id;
+    unsigned int tam_id;
+    unsigned int *inicio;
+    unsigned int n_grupos;
+    unsigned int tam_inicio;
+};
+
+//------------------------------------------------------------------------------
+// acrescenta o vertice de id id ao último grupo de c (se novo_grupo == 0)
+// ou a um novo grupo (se novo_grupo == 1)
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int acrescenta_cadeia(struct cadeia_dot *c, unsigned int id, int novo_grupo){
+    if(c->n_id == c->tam_id){
+        unsigned int tam = c->tam_id ? 2 * c->tam_id : 16;
+        unsigned int *ids = realloc(c->id, tam * sizeof(unsigned int));
+        if(!ids)
+            return 0;
+        c->id = ids;
+        c->tam_id = tam;
+    }
+    if(c->n_grupos + 2 > c->tam_inicio){
+        unsigned int tam = c->tam_inicio ? 2 * c->tam_inicio : 8;
+        unsigned int *inicio = realloc(c->inicio, tam * sizeof(unsigned int));
+        if(!inicio)
+            return 0;
+        c->inicio = inicio;
+        c->tam_inicio = tam;
+    }
+    if(novo_grupo || c->n_grupos == 0)
+        c->inicio[c->n_grupos++] = c->n_id;
+    c->id[c->n_id++] = id;
+    c->inicio[c->n_grupos] = c->n_id;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// lê uma extremidade de um comando de arestas a partir do token *t, que é
+// um T_ID (um vertice) ou um T_ABRE_CHAVE (subgrafo anônimo contendo só
+// vertices), acrescentando-a como um novo grupo de c
+//
+// os vertices de um subgrafo ficam em ordem de criação, que é a ordem em
+// que a libcgraph os percorre ao criar as arestas
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de erro ou de construção não suportada
+
+static int le_extremidade(struct leitor_dot *l, enum token_dot t, grafo g, struct cadeia_dot *c){
+    if(t == T_ID){
+        if(palavra_reservada(l, "graph") || palavra_reservada(l, "node")
+           || palavra_reservada(l, "edge") || palavra_reservada(l, "subgraph"))
+            return 0;
+
+        vertice v = obtem_vertice(g, l->texto);
+        return v && acrescenta_cadeia(c, v->id, 1);
+    }
+    if(t != T_ABRE_CHAVE)
+        return 0;
+
+    int novo_grupo = 1;
+    unsigned int primeiro = c->n_id;
+
+    for(t = proximo_token(l); t != T_FECHA_CHAVE; t = proximo_token(l)){
+        if(t == T_PONTO_VIRGULA || t == T_VIRGULA)
+            continue;
+        if(t != T_ID || palavra_reservada(l, "graph") || palavra_reservada(l, "node")
+           || palavra_reservada(l, "edge") || palavra_reservada(l, "subgraph"))
+            return 0;
+
+        vertice v = obtem_vertice(g, l->texto);
+        if(!v)
+            return 0;
+
+        // ordenação por inserção, sem repetições
+        unsigned int k = c->n_id;
+        while(k > primeiro && c->id[k-1] > v->id)
+            k--;
+        if(k > primeiro && c->id[k-1] == v->id)
+            continue;
+        if(!acrescenta_cadeia(c, v->id, novo_grupo))
+            return 0;
+        memmove(c->id + k + 1, c->id + k, (c->n_id - 1 - k) * sizeof(unsigned int));
+        c->id[k] = v->id;
+        novo_grupo = 0;
+    }
+
+    // subgrafo vazio: grupo sem vertices
+    if(novo_grupo){
+        if(c->n_grupos + 2 > c->tam_inicio){
+            unsigned int tam = c->tam_inicio ? 2 * c->tam_inicio : 8;
+            unsigned int *inicio = realloc(c->inicio, tam * sizeof(unsigned int));
+            if(!inicio)
+                return 0;
+            c->inicio = inicio;
+            c->tam_inicio = tam;
+        }
+        c->inicio[c->n_grupos++] = c->n_id;
+        c->inicio[c->n_grupos] = c->n_id;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// lê os comandos do corpo do grafo (depois do '{' até o '}' correspondente),
+// criando os vertices de g e acumulando as arestas/arcos em a
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de erro ou de construção não suportada
+
+static int le_comandos_dot(struct leitor_dot *l, grafo g, int estrito, struct arestas_dot *a){
+    struct cadeia_dot c = { NULL, 0, 0, NULL, 0, 0 };
+    char *nome = NULL; // nome do primeiro vertice do comando
+    size_t tam_nome = 0;
+    long int peso_default = 0;
+    int ok = 0;
+    enum token_dot t = proximo_token(l);
+
+    while(t != T_FECHA_CHAVE){
+        if(t == T_PONTO_VIRGULA){
+            t = proximo_token(l);
+            continue;
+        }
+        if(t == T_ID && palavra_reservada(l, "subgraph"))
+            goto fim;
+
+        if(t == T_ID && (palavra_reservada(l, "graph") || palavra_reservada(l, "node") || palavra_reservada(l, "edge"))){
+            int atributos_aresta = palavra_reservada(l, "edge");
+            long int peso = 0;
+            int tem_peso = 0;
+
+            t = proximo_token(l);
+            if(t != T_ABRE_COLCHETE || !le_atributos(l, &t, &peso, &tem_peso))
+                goto fim;
+            if(atributos_aresta && tem_peso){
+                // se é a primeira declaração de "peso", a libcgraph atribui o
+                // novo default a todas as arestas já existentes
+                if(!g->ponderado)
+                    for(unsigned int k = 0; k < a->n; k++)
+                        a->peso[k] = peso;
+                peso_default = peso;
+                g->ponderado = 1;
+            }
+            continue;
+        }
+
+        c.n_id = c.n_grupos = 0;
+
+        if(t == T_ID){
+            // o nome é guardado antes de ler o próximo token, que decide se
+            // o comando é uma atribuição de atributo do grafo (id = id)
+            size_t tam_texto = strlen(l->texto) + 1;
+            if(tam_texto > tam_nome){
+                char *n = realloc(nome, tam_texto);
+                if(!n)
+                    goto fim;
+                nome = n;
+                tam_nome = tam_texto;
+            }
+            memcpy(nome, l->texto, tam_texto);
+
+            t = proximo_token(l);
+            if(t == T_IGUAL){
+                if(proximo_token(l) != T_ID)
+                    goto fim;
+                t = proximo_token(l);
+                continue;
+            }
+
+            vertice v = obtem_vertice(g, nome);
+            if(!v || !acrescenta_cadeia(&c, v->id, 1))
+                goto fim;
+        }
+        else{
+            if(!le_extremidade(l, t, g, &c))
+                goto fim;
+            t = proximo_token(l);
+        }
+
+        while(t == T_ARESTA || t == T_ARCO){
+            if((t == T_ARCO) != g->direcionado)
+                goto fim;
+            if(!le_extremidade(l, proximo_token(l), g, &c))
+                goto fim;
+            t = proximo_token(l);
+        }
+
+        long int peso = peso_default;
+        int tem_peso = 0;
+
+        if(t == T_ABRE_COLCHETE && !le_atributos(l, &t, &peso, &tem_peso))
+            goto fim;
+        if(c.n_grupos > 1 && tem_peso){
+            // primeira declaração de "peso": as arestas anteriores ficam com
+            // o default, que é 0
+            g->ponderado = 1;
+        }
+
+        for(unsigned int k = 0; k + 1 < c.n_grupos; k++)
+            for(unsigned int i = c.inicio[k]; i < c.inicio[k+1]; i++)
+                for(unsigned int j = c.inicio[k+1]; j < c.inicio[k+2]; j++)
+                    if(!insere_aresta_dot(a, g->direcionado, estrito, c.id[i], c.id[j], peso, tem_peso))
+                        goto fim;
+    }
+    ok = 1;
+
+fim:
+    free(c.id);
+    free(c.inicio);
+    free(nome);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// lê um grafo no formato dot do texto de tamanho tamanho sem usar a libcgraph
+//
+// o grafo lido é idêntico ao que seria construído a partir da libcgraph:
+// mesmos vertices, na mesma ordem, mesmas arestas/arcos, agrupados pelo
+// vertice de origem na ordem em que foram criados
+//
+// devolve o grafo lido ou
+//         NULL em caso de erro ou de construção não suportada
+
+static grafo le_grafo_dot(const char *texto, size_t tamanho){
+    struct leitor_dot l = { texto, texto + tamanho, texto, NULL, 0, 0, 0 };
+    struct arestas_dot a = { NULL, NULL, NULL, 0, 0, NULL, 0, 0 };
+    grafo g = NULL;
+    int estrito = 0, direcionado;
+    int medir = instrumentado();
+    unsigned long long inicio = fim_fase(medir, E_NS_ANALISE_DOT, 0);
+    enum token_dot t = proximo_token(&l);
+
+    if(t == T_ID && palavra_reservada(&l, "strict")){
+        estrito = 1;
+        t = proximo_token(&l);
+    }
+    if(t != T_ID || !(palavra_reservada(&l, "graph") || palavra_reservada(&l, "digraph")))
+        goto erro;
+    direcionado = palavra_reservada(&l, "digraph");
+
+    t = proximo_token(&l);
+    if(t == T_ID){
+        g = cria_grafo(l.texto, direcionado, 0, 64);
+        t = proximo_token(&l);
+    }
+    else
+        g = cria_grafo("", direcionado, 0, 64);
+
+    if(!g || t != T_ABRE_CHAVE || !le_comandos_dot(&l, g, estrito, &a))
+        goto erro;
+    inicio = fim_fase(medir, E_NS_ANALISE_DOT, inicio);
+
+    // ordena as arestas pelo vertice de origem, de forma estável,
+    // como as devolve a libcgraph (agfstout/agnxtout)
+    unsigned int *conta = calloc(g->n_vertices + 1, sizeof(unsigned int));
+    unsigned int *origem = malloc((a.n ? a.n : 1) * sizeof(unsigned int));
+    unsigned int *destino = malloc((a.n ? a.n : 1) * sizeof(unsigned int));
+    long int *peso = malloc((a.n ? a.n : 1) * sizeof(long int));
+    int ok = conta && origem && destino && peso;
+
+    if(ok){
+        for(unsigned int k = 0; k < a.n; k++)
+            conta[a.origem[k] + 1]++;
+        for(unsigned int i = 0; i < g->n_vertices; i++)
+            conta[i + 1] += conta[i];
+        for(unsigned int k = 0; k < a.n; k++){
+            unsigned int j = conta[a.origem[k]]++;
+            origem[j] = a.origem[k];
+            destino[j] = a.destino[k];
+            peso[j] = a.peso[k];
+        }
+        ok = monta_csr(g, a.n, origem, destino, peso);
+    }
+    free(conta);
+    free(origem);
+    free(destino);
+    free(peso);
+    if(!ok)
+        goto erro;
+    fim_fase(medir, E_NS_MONTA_CSR, inicio);
+
+    free(l.texto);
+    free(a.origem);
+    free(a.destino);
+    free(a.peso);
+    free(a.tabela);
+    return g;
+
+erro:
+    // uma análise que falha (e recorre à libcgraph) também conta como análise
+    fim_fase(medir, E_NS_ANALISE_DOT, inicio);
+    free(l.texto);
+    free(a.origem);
+    free(a.destino);
+    free(a.peso);
+    free(a.tabela);
+    if(g)
+        destroi_grafo(g);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// lê um grafo no formato dot de input usando a libcgraph
+//
+// devolve o grafo lido ou
+//         NULL em caso de erro
+
+static grafo le_grafo_cgraph(FILE *input){
+    int medir = instrumentado();
+    unsigned long long t = fim_fase(medir, E_NS_ESPERA_CGRAPH, 0);
+
+    pthread_mutex_lock(&trava_cgraph);
+    t = fim_fase(medir, E_NS_ESPERA_CGRAPH, t);
+    Agraph_t *Ag = agread(input, NULL);
+    t = fim_fase(medir, E_NS_CGRAPH, t);
+    if(medir)
+        soma_estatistica(E_LEITURAS_CGRAPH, 1);
+   
+    if(!Ag){
+        pthread_mutex_unlock(&trava_cgraph);
+        return NULL;
+    }
+ 
+    grafo g = cria_grafo(agnameof(Ag), agisdirected(Ag), contem_pesos(Ag), agnnodes(Ag));
+ 
+    for (Agnode_t *Av=agfstnode(Ag); Av; Av=agnxtnode(Ag,Av)) {
+            cria_vertice(g, agnameof(Av));
+    }
+ 
+    for (Agnode_t *Av=agfstnode(Ag); Av; Av=agnxtnode(Ag,Av)) {
+        for (Agedge_t *Ae=agfstout(Ag,Av); Ae; Ae=agnxtout(Ag,Ae)) {
+            vertice u = busca_vertice(agnameof(agtail(Ae)), g);
+            vertice v = busca_vertice(agnameof(aghead(Ae)), g);
+            cria_vizinhanca(g, u, v, get_peso(Ae));
+        }
+    }
+   
+    agclose(Ag);
+    agfree(Ag, NULL);
+    pthread_mutex_unlock(&trava_cgraph);
+
+    int ok = congela_grafo(g);
+    fim_fase(medir, E_NS_COPIA_CGRAPH, t);
+    if(!ok){
+        destroi_grafo(g);
+        return NULL;
+    }
+    return g;
+}
+
+//------------------------------------------------------------------------------
+// lê todo o conteúdo de input para um buffer alocado, devolvido com seu
+// tamanho em *tamanho
+//
+// devolve NULL em caso de erro
+
+static char *le_conteudo(FILE *input, size_t *tamanho){
+    size_t capacidade = 1 << 16;
+    char *buffer = malloc(capacidade);
+
+    *tamanho = 0;
+    while(buffer){
+        *tamanho += fread(buffer + *tamanho, 1, capacidade - *tamanho, input);
+        if(*tamanho < capacidade)
+            break;
+        char *novo = realloc(buffer, 2 * capacidade);
+        if(!novo)
+            free(buffer);
+        buffer = novo;
+        capacidade *= 2;
+    }
+    if(buffer && ferror(input)){
+        free(buffer);
+        return NULL;
+    }
+    return buffer;
+}
+
+//------------------------------------------------------------------------------
+// devolve o nome do grafo g
+ 
+char *nome_grafo(grafo g){
+    char nome_g[1];
+    nome_g[0] = '\0';
+    return g ? g->nome : nome_g;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve 1, se g é direcionado, ou
+//         0, caso contrário
+ 
+int direcionado(grafo g){
+    return g ? g->direcionado : 0;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve 1, se g tem pesos nas arestas/arcos,
+//      ou 0, caso contrário
+ 
+int ponderado(grafo g){
+    return g ? g->ponderado : 0;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o número de vértices do grafo g
+ 
+unsigned int n_vertices(grafo g){
+    return g ? g->n_vertices : 0;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o número de arestas/arcos do grafo g
+ 
+unsigned int n_arestas(grafo g){
+    return g ? g->n_arestas : 0;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o nome do vertice v
+ 
+char *nome_vertice(vertice v){
+    char nome_v[1];
+    nome_v[0] = '\0';
+    return v ? v->nome : nome_v;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o id do vertice v, ou UINT_MAX se v é NULL
+
+unsigned int id_vertice(vertice v){
+    return v ? v->id : UINT_MAX;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o vertice de id id em g, ou NULL se não existe
+
+vertice vertice_id(unsigned int id, grafo g){
+    return g && id < g->n_vertices ? g->vertices[id] : NULL;
+}
+ 
+//------------------------------------------------------------------------------
+// lê um grafo no formato dot de input: todo o conteúdo vai para um
+// buffer, analisado pelo leitor próprio (le_grafo_dot()); se ele não
+// reconhece alguma construção, o mesmo buffer é lido com as rotinas de
+// libcgraph
+//
+// desconsidera todos os atributos do grafo lido exceto o atributo
+// "peso" quando ocorrer; neste caso o valor do atributo é o peso da
+// aresta/arco que é um long int
+//
+// num grafo com pesos todas as arestas/arcos tem peso
+//
+// o peso default de uma aresta num grafo com pesos é 0
+//
+// todas as estruturas de dados alocadas pela libcgraph são
+// desalocadas ao final da execução
+//
+// devolve o grafo lido ou
+//         NULL em caso de erro
+ 
+grafo le_grafo(FILE *input){
+    if (!input)
+        return NULL;
+
+    int medir = instrumentado();
+    unsigned long long t = fim_fase(medir, E_LEITURAS, 0);
+    size_t tamanho;
+    char *texto = le_conteudo(input, &tamanho);
+
+    if(medir){
+        soma_estatistica(E_LEITURAS, 1);
+        fim_fase(medir, E_NS_LEITURA_TEXTO, t);
+    }
+    if(!texto)
+        return NULL;
+
+    grafo g = le_grafo_dot(texto, tamanho);
+
+    if(!g && tamanho > 0){
+        // fora do subconjunto suportado pelo leitor próprio: usa a libcgraph
+        FILE *copia = fmemopen(texto, tamanho, "r");
+        if(copia){
+            g = le_grafo_cgraph(copia);
+            fclose(copia);
+        }
+    }
+
+    free(texto);
+    return g;
+}
+ 
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada em *g
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+//
+// g é um (void *) para que destroi_grafo() possa ser usada como argumento de
+// destroi_lista()
+ 
+int destroi_grafo(void *g){
+    if (!g)
+		return 0;
+
+    if(((grafo) g)->mapa){
+        // nomes, índice e vetores CSR estão na imagem mapeada; vertices e
+        // suas estruturas estão num único bloco
+        munmap(((grafo) g)->mapa, ((grafo) g)->tam_mapa);
+        free(((grafo) g)->vertices);
+        free(((grafo) g)->bits);
+        free(g);
+        return 1;
+    }
+ 
+    // vertices, nomes e listas de adjacência estão nas arenas do grafo
+    libera_arena(&((grafo) g)->memoria);
+    libera_arena(&((grafo) g)->construcao);
+    free(((grafo) g)->vertices);
+    free(((grafo) g)->indice);
+    free(((grafo) g)->bits);
+    if(((grafo) g)->direcionado){
+        free(((grafo) g)->inicio_entrada);
+        free(((grafo) g)->alvo_entrada);
+        free(((grafo) g)->peso_entrada);
+    }
+    free(((grafo) g)->inicio_saida);
+    free(((grafo) g)->alvo_saida);
+    free(((grafo) g)->peso_saida);
+    free(g);
+ 
+    return 1;
+}
+ 
+//------------------------------------------------------------------------------
+//FORMATO BINÁRIO
+//------------------------------------------------------------------------------
+// o arquivo binário é uma imagem do grafo congelado que pode ser mapeada em
+// memória (mmap) e usada diretamente, sem análise nem alocação por
+// elemento; todas as referências internas são ids ou deslocamentos, de
+// forma que a imagem não depende do endereço em que é mapeada
+//
+// layout (cada seção começa em múltiplo de 8 bytes, completada com zeros):
+//
+//   cabeçalho (struct cabecalho_binario)
+//   indice          tam_indice unsigned int (tabela hash nome -> id+1)
+//   nome_vertice    n_vertices unsigned int (deslocamento do nome na arena)
+//   inicio_saida    n_vertices+1 unsigned int
+//   alvo_saida      inicio_saida[n_vertices] unsigned int
+//   peso_saida      inicio_saida[n_vertices] long int
+//   inicio_entrada, alvo_entrada, peso_entrada (só em grafos direcionados)
+//   nomes           arena com o nome do grafo seguido dos nomes dos vertices,
+//                   cada um terminado em '\0'
+//
+// a soma de verificação cobre tudo o que vem depois do cabeçalho
+
+#define MAGICA_BINARIO "GRAFOBIN"
+#define VERSAO_BINARIO 1u
+#define ORDEM_BYTES_BINARIO 0x01020304u
+
+struct cabecalho_binario {
+    char magica[8];
+    uint32_t versao;
+    uint32_t ordem_bytes; // detecta arquivos gerados em máquinas com outra ordem de bytes
+    uint32_t tam_long; // sizeof(long int) da máquina que gerou o arquivo
+    uint32_t direcionado;
+    uint32_t ponderado;
+    uint32_t n_vertices;
+    uint32_t n_arestas;
+    uint32_t tam_indice;
+    uint64_t tam_nomes; // tamanho da arena de nomes
+    uint64_t tamanho; // tamanho total do arquivo
+    uint64_t soma; // soma de verificação do conteúdo depois do cabeçalho
+};
+
+//------------------------------------------------------------------------------
+// número de seções do arquivo binário e seus índices
+
+enum secao_binario {
+    S_INDICE,
+    S_NOME_VERTICE,
+    S_INICIO_SAIDA,
+    S_ALVO_SAIDA,
+    S_PESO_SAIDA,
+    S_INICIO_ENTRADA,
+    S_ALVO_ENTRADA,
+    S_PESO_ENTRADA,
+    S_NOMES,
+    N_SECOES
+};
+
+//------------------------------------------------------------------------------
+// arredonda t para o próximo múltiplo de 8
+
+static uint64_t alinha8(uint64_t t){
+    return (t + 7) & ~(uint64_t) 7;
+}
+
+//------------------------------------------------------------------------------
+// preenche tam[] com o tamanho em bytes de cada seção do arquivo descrito
+// por c e devolve o tamanho total do arquivo, ou 0 se as seções não cabem em
+// limite bytes
+//
+// cada seção é comparada com o que resta de limite antes de ser somada, de
+// modo que um cabeçalho forjado (tam_nomes perto de 2^64, por exemplo) não
+// faz a soma dar a volta e coincidir com o tamanho do arquivo
+
+static uint64_t tamanho_secoes(const struct cabecalho_binario *c, uint64_t tam[N_SECOES],
+                               uint64_t limite){
+    uint64_t n = c->n_vertices;
+    uint64_t total_saida = c->direcionado ? c->n_arestas : 2 * (uint64_t) c->n_arestas;
+    uint64_t total_entrada = c->direcionado ? c->n_arestas : 0;
+    uint64_t soma = sizeof(struct cabecalho_binario);
+
+    tam[S_INDICE] = c->tam_indice * sizeof(unsigned int);
+    tam[S_NOME_VERTICE] = n * sizeof(unsigned int);
+    tam[S_INICIO_SAIDA] = (n + 1) * sizeof(unsigned int);
+    tam[S_ALVO_SAIDA] = total_saida * sizeof(unsigned int);
+    tam[S_PESO_SAIDA] = total_saida * sizeof(long int);
+    tam[S_INICIO_ENTRADA] = c->direcionado ? (n + 1) * sizeof(unsigned int) : 0;
+    tam[S_ALVO_ENTRADA] = total_entrada * sizeof(unsigned int);
+    tam[S_PESO_ENTRADA] = total_entrada * sizeof(long int);
+    tam[S_NOMES] = c->tam_nomes;
+
+    if(soma > limite)
+        return 0;
+    // como soma >= sizeof(struct cabecalho_binario), tam[i] <= limite - soma
+    // fica longe de 2^64 e alinha8() não dá a volta
+    for(int i = 0; i < N_SECOES; i++){
+        if(tam[i] > limite - soma)
+            return 0;
+        soma += alinha8(tam[i]);
+        if(soma > limite)
+            return 0;
+    }
+    return soma;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se inicio (n+1 posições) começa em 0, não decresce e termina em
+//            total, e cada uma das total posições de alvo é um id menor que n,
+//            ou
+//         0, caso contrário
+
+static int verifica_csr_binario(const unsigned int *inicio, const unsigned int *alvo,
+                                uint64_t n, uint64_t total){
+    if(inicio[0] != 0 || inicio[n] != total)
+        return 0;
+    for(uint64_t i = 0; i < n; i++)
+        if(inicio[i] > inicio[i+1])
+            return 0;
+    for(uint64_t j = 0; j < total; j++)
+        if(alvo[j] >= n)
+            return 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se os vetores de ids da imagem com cabeçalho c e seções secao
+//            são consistentes: nomes terminados em '\0', vetores CSR válidos
+//            (verifica_csr_binario()) e índice só com posições livres (0) ou
+//            ids+1, com pelo menos uma livre para que as buscas parem, ou
+//         0, caso contrário
+//
+// a soma de verificação só detecta arquivos corrompidos por acidente; estas
+// verificações garantem que nenhum algoritmo lê fora dos vetores, mesmo num
+// arquivo montado de propósito
+
+static int verifica_vetores_binario(const struct cabecalho_binario *c, char *secao[N_SECOES]){
+    uint64_t n = c->n_vertices;
+    uint64_t total_saida = c->direcionado ? c->n_arestas : 2 * (uint64_t) c->n_arestas;
+    const unsigned int *nome_vertice = (const unsigned int *) (void *) secao[S_NOME_VERTICE];
+    const unsigned int *indice = (const unsigned int *) (void *) secao[S_INDICE];
+    uint64_t livres = 0;
+
+    if(secao[S_NOMES][c->tam_nomes - 1] != '\0')
+        return 0;
+    for(uint64_t i = 0; i < n; i++)
+        if(nome_vertice[i] >= c->tam_nomes)
+            return 0;
+    for(uint64_t i = 0; i < c->tam_indice; i++){
+        if(indice[i] > n)
+            return 0;
+        livres += indice[i] == 0;
+    }
+    if(livres == 0)
+        return 0;
+
+    if(!verifica_csr_binario((const unsigned int *) (void *) secao[S_INICIO_SAIDA],
+                             (const unsigned int *) (void *) secao[S_ALVO_SAIDA], n, total_saida))
+        return 0;
+    return !c->direcionado
+        || verifica_csr_binario((const unsigned int *) (void *) secao[S_INICIO_ENTRADA],
+                                (const unsigned int *) (void *) secao[S_ALVO_ENTRADA], n, c->n_arestas);
+}
+
+//------------------------------------------------------------------------------
+// acumula em *soma a soma de verificação dos tam bytes de dados, completados
+// com zeros até um múltiplo de 8
+//
+// a soma é feita palavra a palavra (64 bits), de forma que somar as seções
+// uma a uma dá o mesmo resultado que somar o arquivo de uma vez
+
+static void acumula_soma(uint64_t *soma, const void *dados, uint64_t tam){
+    const unsigned char *p = dados;
+    uint64_t h = *soma;
+
+    for(uint64_t i = 0; i < alinha8(tam); i += 8){
+        uint64_t palavra = 0;
+
+        if(i + 8 <= tam)
+            memcpy(&palavra, p + i, 8);
+        else
+            memcpy(&palavra, p + i, (size_t) (tam - i));
+        h ^= palavra;
+        h *= 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    *soma = h;
+}
+
+//------------------------------------------------------------------------------
+// escreve o grafo g em output no formato binário (ver carrega_grafo_binario())
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de erro
+
+int salva_grafo_binario(FILE *output, grafo g){
+    if(!g || !output || !g->congelado)
+        return 0;
+
+    struct cabecalho_binario c;
+    uint64_t tam[N_SECOES];
+    const void *dados[N_SECOES];
+    unsigned int *nome_vertice = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    uint64_t tam_nomes = strlen(g->nome) + 1;
+
+    if(!nome_vertice)
+        return 0;
+    for(unsigned int i = 0; i < g->n_vertices; i++){
+        if(tam_nomes > UINT_MAX){
+            free(nome_vertice);
+            return 0;
+        }
+        nome_vertice[i] = (unsigned int) tam_nomes;
+        tam_nomes += strlen(g->vertices[i]->nome) + 1;
+    }
+
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magica, MAGICA_BINARIO, sizeof(c.magica));
+    c.versao = VERSAO_BINARIO;
+    c.ordem_bytes = ORDEM_BYTES_BINARIO;
+    c.tam_long = sizeof(long int);
+    c.direcionado = (uint32_t) g->direcionado;
+    c.ponderado = (uint32_t) g->ponderado;
+    c.n_vertices = g->n_vertices;
+    c.n_arestas = g->n_arestas;
+    c.tam_indice = g->tam_indice;
+    c.tam_nomes = tam_nomes;
+    c.tamanho = tamanho_secoes(&c, tam, UINT64_MAX);
+
+    dados[S_INDICE] = g->indice;
+    dados[S_NOME_VERTICE] = nome_vertice;
+    dados[S_INICIO_SAIDA] = g->inicio_saida;
+    dados[S_ALVO_SAIDA] = g->alvo_saida;
+    dados[S_PESO_SAIDA] = g->peso_saida;
+    dados[S_INICIO_ENTRADA] = g->inicio_entrada;
+    dados[S_ALVO_ENTRADA] = g->alvo_entrada;
+    dados[S_PESO_ENTRADA] = g->peso_entrada;
+    dados[S_NOMES] = NULL;
+
+    // a arena de nomes não existe em memória: é escrita (e somada) nome a
+    // nome, com um buffer para completar as palavras de 64 bits
+    c.soma = 0xcbf29ce484222325ull;
+    for(int i = 0; i < S_NOMES; i++)
+        acumula_soma(&c.soma, dados[i], tam[i]);
+
+    char *nomes = malloc(tam_nomes);
+    if(!nomes){
+        free(nome_vertice);
+        return 0;
+    }
+    memcpy(nomes, g->nome, strlen(g->nome) + 1);
+    for(unsigned int i = 0; i < g->n_vertices; i++)
+        memcpy(nomes + nome_vertice[i], g->vertices[i]->nome, strlen(g->vertices[i]->nome) + 1);
+    dados[S_NOMES] = nomes;
+    acumula_soma(&c.soma, nomes, tam_nomes);
+
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    int ok = fwrite(&c, sizeof(c), 1, output) == 1;
+
+    for(int i = 0; ok && i < N_SECOES; i++){
+        if(tam[i] > 0)
+            ok = fwrite(dados[i], (size_t) tam[i], 1, output) == 1;
+        if(ok && alinha8(tam[i]) > tam[i])
+            ok = fwrite(zeros, (size_t) (alinha8(tam[i]) - tam[i]), 1, output) == 1;
+    }
+
+    free(nomes);
+    free(nome_vertice);
+    return ok && fflush(output) == 0;
+}
+
+//------------------------------------------------------------------------------
+// lê um grafo no formato binário gravado por salva_grafo_binario(),
+// mapeando input em memória
+//
+// devolve o grafo lido ou
+//         NULL em caso de erro (arquivo de outra versão, de outra arquitetura,
+//              truncado ou corrompido)
+
+grafo carrega_grafo_binario(FILE *input){
+    if(!input)
+        return NULL;
+
+    struct stat st;
+    int fd = fileno(input);
+
+    if(fd < 0 || fstat(fd, &st) != 0 || (uint64_t) st.st_size < sizeof(struct cabecalho_binario))
+        return NULL;
+
+    size_t tamanho = (size_t) st.st_size;
+    char *mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(mapa == MAP_FAILED)
+        return NULL;
+
+    struct cabecalho_binario c;
+    uint64_t tam[N_SECOES];
+    char *secao[N_SECOES];
+
+    memcpy(&c, mapa, sizeof(c));
+    if(memcmp(c.magica, MAGICA_BINARIO, sizeof(c.magica)) != 0 || c.versao != VERSAO_BINARIO
+       || c.ordem_bytes != ORDEM_BYTES_BINARIO || c.tam_long != sizeof(long int)
+       || c.tamanho != tamanho || tamanho_secoes(&c, tam, tamanho) != tamanho
+       || c.tam_indice == 0 || (c.tam_indice & (c.tam_indice - 1)) != 0 || c.tam_nomes == 0)
+        goto erro;
+
+    uint64_t soma = 0xcbf29ce484222325ull;
+    acumula_soma(&soma, mapa + sizeof(c), tamanho - sizeof(c));
+    if(soma != c.soma)
+        goto erro;
+
+    secao[0] = mapa + sizeof(c);
+    for(int i = 1; i < N_SECOES; i++)
+        secao[i] = secao[i-1] + alinha8(tam[i-1]);
+
+    char *nomes = secao[S_NOMES];
+    unsigned int *nome_vertice = (unsigned int *) (void *) secao[S_NOME_VERTICE];
+    unsigned int *inicio_saida = (unsigned int *) (void *) secao[S_INICIO_SAIDA];
+
+    if(!verifica_vetores_binario(&c, secao))
+        goto erro;
+
+    grafo g = malloc(sizeof(struct grafo));
+    // o vetor de apontadores e as estruturas dos vertices ficam num único bloco
+    vertice *vertices = malloc(c.n_vertices * (sizeof(vertice) + sizeof(struct vertice)) + 1);
+
+    if(!g || !vertices){
+        free(g);
+        free(vertices);
+        goto erro;
+    }
+
+    struct vertice *bloco = (struct vertice *) (void *) (vertices + c.n_vertices);
+
+    g->nome = nomes;
+    g->direcionado = (int) c.direcionado;
+    g->ponderado = (int) c.ponderado;
+    g->n_vertices = c.n_vertices;
+    g->n_arestas = c.n_arestas;
+    g->capacidade = c.n_vertices;
+    g->congelado = 1;
+    g->vertices = vertices;
+    g->indice = (unsigned int *) (void *) secao[S_INDICE];
+    g->tam_indice = c.tam_indice;
+    g->inicio_saida = inicio_saida;
+    g->alvo_saida = (unsigned int *) (void *) secao[S_ALVO_SAIDA];
+    g->peso_saida = (long int *) (void *) secao[S_PESO_SAIDA];
+    if(c.direcionado){
+        g->inicio_entrada = (unsigned int *) (void *) secao[S_INICIO_ENTRADA];
+        g->alvo_entrada = (unsigned int *) (void *) secao[S_ALVO_ENTRADA];
+        g->peso_entrada = (long int *) (void *) secao[S_PESO_ENTRADA];
+    }
+    else{
+        g->inicio_entrada = g->inicio_saida;
+        g->alvo_entrada = g->alvo_saida;
+        g->peso_entrada = g->peso_saida;
+    }
+    g->mapa = mapa;
+    g->tam_mapa = tamanho;
+    g->bits = NULL;
+    inicia_arena(&g->memoria, 0);
+    inicia_arena(&g->construcao, 0);
+
+    memset(bloco, 0, c.n_vertices * sizeof(struct vertice));
+    for(unsigned int i = 0; i < c.n_vertices; i++){
+        vertice v = &bloco[i];
+        v->nome = nomes + nome_vertice[i];
+        v->id = i;
+        vertices[i] = v;
+    }
+    return g;
+
+erro:
+    munmap(mapa, tamanho);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// devolve uma cópia dos tam bytes em v, alocada com malloc(), ou
+//         NULL em caso de falta de memória
+
+static void *duplica(const void *v, size_t tam){
+    void *copia = malloc(tam ? tam : 1);
+
+    if(copia && tam)
+        memcpy(copia, v, tam);
+    return copia;
+}
+
+//------------------------------------------------------------------------------
+// devolve um grafo igual a g, que não compartilha nada com g, ou
+//         NULL em caso de falta de memória
+//
+// a cópia é feita em poucas alocações: o nome do grafo, todos os vertices e
+// todos os nomes ficam num único bloco da arena da cópia; o índice e os
+// vetores CSR, que só têm ids, são copiados inteiros
+
+grafo copia_grafo(grafo g){
+    if(!g)
+        return NULL;
+
+    grafo copia = malloc(sizeof(struct grafo));
+    if(!copia){
+        printf("Sem memoria para alocar.\n");
+        return NULL;
+    }
+
+    unsigned int n = g->n_vertices;
+    size_t tam_nomes = strlen(g->nome) + 1;
+    for(unsigned int i = 0; i < n; i++)
+        tam_nomes += strlen(g->vertices[i]->nome) + 1;
+    size_t tam_bloco = n * sizeof(struct vertice) + tam_nomes;
+
+    // a arena começa com um bloco do tamanho exato do que a cópia precisa
+    inicia_arena(&copia->memoria, tam_bloco);
+    inicia_arena(&copia->construcao, 0);
+    copia->direcionado = g->direcionado;
+    copia->ponderado = g->ponderado;
+    copia->n_vertices = n;
+    copia->n_arestas = g->n_arestas;
+    copia->capacidade = n ? n : 1;
+    copia->congelado = 1;
+    copia->tam_indice = g->tam_indice;
+    copia->bits = NULL;
+    copia->mapa = NULL;
+    copia->tam_mapa = 0;
+
+    unsigned int total_saida = g->inicio_saida[n];
+    struct vertice *bloco = aloca_arena(&copia->memoria, tam_bloco);
+    copia->vertices = malloc(copia->capacidade * sizeof(vertice));
+    copia->indice = duplica(g->indice, g->tam_indice * sizeof(unsigned int));
+    copia->inicio_saida = duplica(g->inicio_saida, (n + 1) * sizeof(unsigned int));
+    copia->alvo_saida = duplica(g->alvo_saida, total_saida * sizeof(unsigned int));
+    copia->peso_saida = duplica(g->peso_saida, total_saida * sizeof(long int));
+    if(g->direcionado){
+        unsigned int total_entrada = g->inicio_entrada[n];
+        copia->inicio_entrada = duplica(g->inicio_entrada, (n + 1) * sizeof(unsigned int));
+        copia->alvo_entrada = duplica(g->alvo_entrada, total_entrada * sizeof(unsigned int));
+        copia->peso_entrada = duplica(g->peso_entrada, total_entrada * sizeof(long int));
+    }
+    else{
+        copia->inicio_entrada = copia->inicio_saida;
+        copia->alvo_entrada = copia->alvo_saida;
+        copia->peso_entrada = copia->peso_saida;
+    }
+
+    if(!bloco || !copia->vertices || !copia->indice || !copia->inicio_saida || !copia->alvo_saida
+       || !copia->peso_saida || !copia->inicio_entrada || !copia->alvo_entrada || !copia->peso_entrada){
+        printf("Sem memoria para alocar.\n");
+        destroi_grafo(copia);
+        return NULL;
+    }
+
+    // os nomes vêm logo depois dos vertices no bloco
+    char *nome = (char *) (bloco + n);
+    size_t tam = strlen(g->nome) + 1;
+    copia->nome = memcpy(nome, g->nome, tam);
+    nome += tam;
+    for(unsigned int i = 0; i < n; i++){
+        vertice v = &bloco[i];
+        tam = strlen(g->vertices[i]->nome) + 1;
+        v->nome = memcpy(nome, g->vertices[i]->nome, tam);
+        nome += tam;
+        v->id = i;
+        v->padding = 0;
+        v->adjacencias_entrada = v->adjacencias_saida = NULL;
+        copia->vertices[i] = v;
+    }
+    return copia;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve em *fim o fim e como retorno o início do intervalo do vetor alvo
+// (g->alvo_saida ou g->alvo_entrada) com os vizinhos do vertice v
+//
+// se direcao == -1 o intervalo é o da vizinhança de entrada,
+// caso contrário o da vizinhança de saída
+
+static unsigned int intervalo_vizinhos(vertice v, int direcao, grafo g, unsigned int *fim){
+    unsigned int *inicio = direcao == -1 ? g->inicio_entrada : g->inicio_saida;
+
+    *fim = inicio[v->id + 1];
+    return inicio[v->id];
+}
+ 
+//------------------------------------------------------------------------------
+// devolve a vizinhança do vértice v
+//
+// se direcao == 0, v é um vértice de um grafo não direcionado
+//                  e a função devolve sua vizinhanca
+//
+// se direcao == -1, v é um vértice de um grafo direcionado e a função
+//                   devolve sua vizinhanca de entrada
+//
+// se direcao == 1, v é um vértice de um grafo direcionado e a função
+//                  devolve sua vizinhanca de saída
+ 
+lista vizinhanca(vertice v, int direcao, grafo g){
+    if (!g)
+        return NULL;
    
-    free(((grafo) g)->vertices);
-    free(((grafo) g)->nome);
-    free(g);
+    if(direcao != -1 && direcao != 0 && direcao != 1)
+        return NULL;
+
+    cursor_vizinhos c;
+    lista viz = constroi_lista();
+
+    inicia_vizinhos(&c, v, direcao, g);
+    for(vertice w = proximo_vizinho(&c, NULL); w; w = proximo_vizinho(&c, NULL))
+        insere_lista(w, viz);
+
+    return viz;
+}
+ 
+//------------------------------------------------------------------------------
+// devolve o grau do vértice v
+// i
+// se direcao == 0, v é um vértice de um grafo não direcionado
+//                  e a função devolve seu grau
+//
+// se direcao == -1, v é um vértice de um grafo direcionado
+//                   e a função devolve seu grau de entrada
+//
+// se direcao == 1, v é um vértice de um grafo direcionado
+//                  e a função devolve seu grau de saída
+ 
+unsigned int grau(vertice v, int direcao, grafo g){
+    if (!g)
+        return 0;
+    unsigned int fim;
+    unsigned int inicio = intervalo_vizinhos(v, direcao < 0 ? -1 : 1, g, &fim);
+
+    return fim - inicio;
+}
+
+//------------------------------------------------------------------------------
+// posiciona o cursor c no início da vizinhança do vértice v no grafo g
+//
+// o cursor só guarda os vetores CSR e o intervalo da vizinhança; percorrer
+// a vizinhança não aloca memória
+
+void inicia_vizinhos(cursor_vizinhos *c, vertice v, int direcao, grafo g){
+    c->atual = c->fim = 0;
+    c->vertices = NULL;
+    c->alvo = NULL;
+    c->peso = NULL;
+
+    if(!g || !v || (direcao != -1 && direcao != 0 && direcao != 1))
+        return;
+
+    c->vertices = g->vertices;
+    c->alvo = direcao == -1 ? g->alvo_entrada : g->alvo_saida;
+    c->peso = direcao == -1 ? g->peso_entrada : g->peso_saida;
+    c->atual = intervalo_vizinhos(v, direcao, g, &c->fim);
+}
+
+//------------------------------------------------------------------------------
+// devolve o próximo vizinho do cursor c, ou
+//         NULL, se a vizinhança já foi toda percorrida
+//
+// se peso != NULL, *peso recebe o peso da aresta/arco até o vizinho
+
+vertice proximo_vizinho(cursor_vizinhos *c, long int *peso){
+    if(c->atual >= c->fim)
+        return NULL;
+
+    if(peso)
+        *peso = c->peso[c->atual];
+    return c->vertices[c->alvo[c->atual++]];
+}
+
+//------------------------------------------------------------------------------
+//ÁREA DE TRABALHO
+//------------------------------------------------------------------------------
+// cria uma área de trabalho vazia; os vetores são alocados sob demanda
+//
+// devolve a área criada ou
+//         NULL em caso de falta de memória
+
+area_trabalho cria_area_trabalho(void){
+    area_trabalho a = malloc(sizeof(struct area_trabalho));
+
+    if(!a)
+        return NULL;
+
+    a->marca = NULL;
+    a->capacidade = 0;
+    a->carimbo = 0;
+    a->conjunto = NULL;
+    a->palavras = 0;
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada em a
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int destroi_area_trabalho(area_trabalho a){
+    if(!a)
+        return 0;
+
+    free(a->marca);
+    free(a->conjunto);
+    free(a);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// cada thread tem sua própria área de trabalho, usada por clique() e
+// simplicial(), criada na primeira chamada e desalocada quando a thread
+// termina
+
+static pthread_key_t chave_area;
+static pthread_once_t chave_area_criada = PTHREAD_ONCE_INIT;
+static int tem_chave_area = 0;
+
+static void libera_area_thread(void *a){
+    destroi_area_trabalho(a);
+}
+
+static void cria_chave_area(void){
+    tem_chave_area = pthread_key_create(&chave_area, libera_area_thread) == 0;
+}
+
+//------------------------------------------------------------------------------
+// devolve a área de trabalho da thread que chama, ou
+//         NULL em caso de erro
+
+static area_trabalho area_da_thread(void){
+    pthread_once(&chave_area_criada, cria_chave_area);
+    if(!tem_chave_area)
+        return NULL;
+
+    area_trabalho a = pthread_getspecific(chave_area);
+    if(!a){
+        a = cria_area_trabalho();
+        if(a && pthread_setspecific(chave_area, a) != 0){
+            destroi_area_trabalho(a);
+            a = NULL;
+        }
+    }
+    return a;
+}
+
+//------------------------------------------------------------------------------
+// reserva quantos carimbos novos em a para um grafo de n vertices e
+// devolve o primeiro deles, ou
+//         0 em caso de falta de memória
+//
+// a->marca tem 2*capacidade posições: marca[id] indica se o vertice id está
+// no conjunto e marca[capacidade+id] se já foi contado como vizinho do
+// vertice atual; como o carimbo só cresce, marcas antigas (inclusive de
+// outros grafos) nunca são confundidas com as novas, e os vetores só são
+// zerados quando crescem ou quando o carimbo dá a volta
+
+static unsigned int reserva_carimbos(area_trabalho a, unsigned int n, unsigned int quantos){
+    if(a->capacidade < n || !a->marca){
+        free(a->marca);
+        a->marca = calloc(2 * (size_t) n + 1, sizeof(unsigned int));
+        a->capacidade = a->marca ? n : 0;
+        a->carimbo = 0;
+        if(!a->marca)
+            return 0;
+    }
+    if(a->carimbo > UINT_MAX - quantos - 1){
+        memset(a->marca, 0, 2 * (size_t) a->capacidade * sizeof(unsigned int));
+        a->carimbo = 0;
+    }
+    a->carimbo += quantos;
+    return a->carimbo - quantos + 1;
+}
+
+//------------------------------------------------------------------------------
+// garante que a->conjunto tem pelo menos palavras palavras (zeradas e
+// alinhadas a 32 bytes)
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int reserva_conjunto(area_trabalho a, unsigned int palavras){
+    if(a->palavras >= palavras)
+        return 1;
+
+    void *conjunto;
+    if(posix_memalign(&conjunto, 32, palavras * sizeof(uint64_t)) != 0)
+        return 0;
+    memset(conjunto, 0, palavras * sizeof(uint64_t));
+    free(a->conjunto);
+    a->conjunto = conjunto;
+    a->palavras = palavras;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+//ESCRITA DO FORMATO DOT
+//------------------------------------------------------------------------------
+// escreve_grafo() gera o texto diretamente a partir do CSR, num buffer de
+// tamanho fixo que é despejado em output com fwrite() quando enche, sem
+// construir um grafo da libcgraph; os IDs seguem as regras de agwrite()
+
+#define TAM_BUFFER_SAIDA (1 << 16)
+
+struct saida_dot {
+    FILE *output;
+    char *dados; // TAM_BUFFER_SAIDA bytes
+    size_t usado;
+    int erro; // 1 se alguma escrita em output falhou
+    int padding; // só pra evitar warning
+};
+
+//------------------------------------------------------------------------------
+// escreve em s->output o conteúdo do buffer de s e o esvazia
+
+static void despeja_saida(struct saida_dot *s){
+    if(s->usado > 0 && fwrite(s->dados, 1, s->usado, s->output) != s->usado)
+        s->erro = 1;
+    s->usado = 0;
+}
+
+//------------------------------------------------------------------------------
+// acrescenta os tam bytes de p ao buffer de s
+
+static void escreve_bytes(struct saida_dot *s, const char *p, size_t tam){
+    while(tam > 0){
+        if(s->usado == TAM_BUFFER_SAIDA)
+            despeja_saida(s);
+
+        size_t k = TAM_BUFFER_SAIDA - s->usado;
+        if(k > tam)
+            k = tam;
+        memcpy(s->dados + s->usado, p, k);
+        s->usado += k;
+        p += k;
+        tam -= k;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+static void escreve_texto(struct saida_dot *s, const char *texto){
+    escreve_bytes(s, texto, strlen(texto));
+}
+
+//------------------------------------------------------------------------------
+// acrescenta x em decimal ao buffer de s, sem passar por printf()
+
+static void escreve_inteiro(struct saida_dot *s, long int x){
+    char digitos[24];
+    unsigned int k = sizeof(digitos);
+    unsigned long int u = x < 0 ? 0ul - (unsigned long int) x : (unsigned long int) x;
+
+    do{
+        digitos[--k] = (char) ('0' + u % 10);
+        u /= 10;
+    }while(u > 0);
+    if(x < 0)
+        digitos[--k] = '-';
+    escreve_bytes(s, digitos + k, sizeof(digitos) - k);
+}
+
+//------------------------------------------------------------------------------
+// devolve 1 se o ID nome precisa ser escrito entre aspas ou
+//         0 caso contrário
+//
+// como em agwrite(), ficam sem aspas os numerais (-?(.[0-9]+|[0-9]+(.[0-9]*)?))
+// e os identificadores (letras, dígitos, '_' e bytes não ASCII, sem começar
+// por dígito) que não são palavras reservadas
+
+static int precisa_aspas(const char *nome){
+    static const char *reservadas[] = { "node", "edge", "graph", "digraph", "subgraph", "strict" };
+    const unsigned char *c = (const unsigned char *) nome;
+
+    if(*c == '\0')
+        return 1;
+
+    if(*c == '-' || *c == '.' || (*c >= '0' && *c <= '9')){
+        unsigned int digitos = 0, pontos = 0;
+
+        if(*c == '-')
+            c++;
+        for(; *c; c++){
+            if(*c >= '0' && *c <= '9')
+                digitos++;
+            else if(*c == '.' && pontos++ == 0)
+                continue;
+            else
+                return 1;
+        }
+        return digitos == 0;
+    }
+
+    for(; *c; c++)
+        if(!((*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9')
+             || *c == '_' || *c >= 128))
+            return 1;
+
+    for(unsigned int i = 0; i < sizeof(reservadas) / sizeof(reservadas[0]); i++){
+        const char *p = reservadas[i];
+        for(c = (const unsigned char *) nome; *c && *p; c++, p++)
+            if((*c >= 'A' && *c <= 'Z' ? *c - 'A' + 'a' : *c) != *p)
+                break;
+        if(*c == '\0' && *p == '\0')
+            return 1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// acrescenta o ID nome ao buffer de s, entre aspas (com '"' escapado) se
+// necessário
+
+static void escreve_id(struct saida_dot *s, const char *nome){
+    if(!precisa_aspas(nome)){
+        escreve_texto(s, nome);
+        return;
+    }
+
+    escreve_bytes(s, "\"", 1);
+    for(const char *c = nome; *c; ){
+        size_t k = strcspn(c, "\"");
+        escreve_bytes(s, c, k);
+        c += k;
+        if(*c == '"'){
+            escreve_bytes(s, "\\\"", 2);
+            c++;
+        }
+    }
+    escreve_bytes(s, "\"", 1);
+}
+
+//------------------------------------------------------------------------------
+// escreve o grafo g em output usando o formato dot, de forma que
+//
+// 1. todos os vértices são escritos antes de todas as arestas/arcos
+//
+// 2. se uma aresta tem peso, este deve ser escrito como um atributo
+//    de nome "peso"
+//
+// o grafo é escrito como estrito, como fazia a libcgraph: num grafo não
+// direcionado cada aresta {u,w} aparece duas vezes no CSR e é escrita uma
+// só vez, a partir do menor id; arestas/arcos repetidos (de um arquivo não
+// estrito) são escritos uma única vez, com o peso da primeira ocorrência,
+// com os carimbos da área de trabalho da thread
+//
+// os vértices são escritos em ordem de id, e as arestas/arcos de cada
+// vértice na ordem em que foram lidos
+//
+// devolve o grafo escrito ou
+//         NULL em caso de erro
+ 
+grafo escreve_grafo(FILE *output, grafo g){
+    if(!g || !output)
+        return NULL;
+
+    int medir = instrumentado();
+    unsigned long long t = fim_fase(medir, E_NS_ESCRITA, 0);
+    unsigned int n = g->n_vertices;
+    area_trabalho a = area_da_thread();
+    unsigned int carimbo = a && n > 0 ? reserva_carimbos(a, n, n) : 0;
+    struct saida_dot s = { output, malloc(TAM_BUFFER_SAIDA), 0, 0, 0 };
+
+    if(!s.dados || (n > 0 && carimbo == 0)){
+        free(s.dados);
+        return NULL;
+    }
+
+    escreve_texto(&s, g->direcionado ? "strict digraph " : "strict graph ");
+    if(g->nome[0]){
+        escreve_id(&s, g->nome);
+        escreve_bytes(&s, " ", 1);
+    }
+    escreve_bytes(&s, "{\n", 2);
+
+    for(unsigned int i = 0; i < n; i++){
+        escreve_bytes(&s, "\t", 1);
+        escreve_id(&s, g->vertices[i]->nome);
+        escreve_bytes(&s, ";\n", 2);
+    }
+
+    // o CSR guarda os vizinhos na ordem inversa da leitura, e por isso é
+    // percorrido de trás para a frente
+    const char *ligacao = g->direcionado ? " -> " : " -- ";
+    for(unsigned int u = 0; u < n; u++, carimbo++){
+        for(unsigned int j = g->inicio_saida[u+1]; j-- > g->inicio_saida[u]; ){
+            unsigned int w = g->alvo_saida[j];
+
+            // a aresta {u,w}, w < u, já foi escrita a partir de w
+            if((!g->direcionado && w < u) || a->marca[w] == carimbo)
+                continue;
+            a->marca[w] = carimbo;
+
+            escreve_bytes(&s, "\t", 1);
+            escreve_id(&s, g->vertices[u]->nome);
+            escreve_bytes(&s, ligacao, 4);
+            escreve_id(&s, g->vertices[w]->nome);
+            if(g->ponderado){
+                escreve_bytes(&s, "\t[peso=", 7);
+                escreve_inteiro(&s, g->peso_saida[j]);
+                escreve_bytes(&s, "]", 1);
+            }
+            escreve_bytes(&s, ";\n", 2);
+        }
+    }
+    escreve_bytes(&s, "}\n", 2);
+    despeja_saida(&s);
+    free(s.dados);
+
+    if(medir){
+        soma_estatistica(E_ESCRITAS, 1);
+        fim_fase(medir, E_NS_ESCRITA, t);
+    }
+    return s.erro ? NULL : g;
+}
+
+//------------------------------------------------------------------------------
+//MATRIZ DE ADJACÊNCIA EM BITS
+//------------------------------------------------------------------------------
+// a linha do vertice de id u é g->bits + u*PALAVRAS(g); o bit w da linha
+// (palavra w/64, bit w%64) é 1 se e somente se u e w são vizinhos. as linhas
+// têm um número de palavras múltiplo de 4 e começam em endereço múltiplo de
+// 32 bytes, para que os kernels AVX2 trabalhem com 4 palavras por vez
+
+#define PALAVRAS(g) ((((g)->n_vertices + 63) / 64 + 3) & ~3u)
+#define LINHA(bits, g, u) ((bits) + (size_t) (u) * PALAVRAS(g))
+#define TEM_BIT(linha, w) (((linha)[(w) >> 6] >> ((w) & 63)) & 1u)
+#define LIGA_BIT(linha, w) ((linha)[(w) >> 6] |= (uint64_t) 1 << ((w) & 63))
+#define DESLIGA_BIT(linha, w) ((linha)[(w) >> 6] &= ~((uint64_t) 1 << ((w) & 63)))
+
+//------------------------------------------------------------------------------
+// devolve o número de bits 1 de x
+
+static unsigned int conta_bits(uint64_t x){
+#ifdef __GNUC__
+    return (unsigned int) __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (unsigned int) ((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// devolve o número de bits 1 de a & b, com palavras palavras (versão
+// portável)
+
+static unsigned int conta_comum_64(const uint64_t *a, const uint64_t *b, unsigned int palavras){
+    unsigned int total = 0;
+
+    for(unsigned int i = 0; i < palavras; i++)
+        total += conta_bits(a[i] & b[i]);
+    return total;
+}
+
+#ifdef BITSET_AVX2
+//------------------------------------------------------------------------------
+// devolve o número de bits 1 de a & b, com palavras palavras (múltiplo de 4,
+// a e b alinhados a 32 bytes), com AVX2
+//
+// a contagem é feita por tabela de 4 bits (vpshufb) em cada byte, e os bytes
+// são somados em grupos de 8 (vpsadbw) em 4 acumuladores de 64 bits
+
+__attribute__((target("avx2")))
+static unsigned int conta_comum_avx2(const uint64_t *a, const uint64_t *b, unsigned int palavras){
+    const __m256i tabela = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mascara = _mm256_set1_epi8(0x0f);
+    __m256i soma = _mm256_setzero_si256();
+
+    for(unsigned int i = 0; i < palavras; i += 4){
+        __m256i x = _mm256_and_si256(_mm256_load_si256((const __m256i *) (const void *) (a + i)),
+                                     _mm256_load_si256((const __m256i *) (const void *) (b + i)));
+        __m256i baixo = _mm256_and_si256(x, mascara);
+        __m256i alto = _mm256_and_si256(_mm256_srli_epi16(x, 4), mascara);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(tabela, baixo),
+                                        _mm256_shuffle_epi8(tabela, alto));
+        soma = _mm256_add_epi64(soma, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    uint64_t parcial[4];
+    _mm256_storeu_si256((__m256i *) (void *) parcial, soma);
+    return (unsigned int) (parcial[0] + parcial[1] + parcial[2] + parcial[3]);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// devolve o número de bits 1 de a & b (duas linhas de g), usando AVX2 se o
+// processador tiver
+
+static unsigned int conta_comum(grafo g, const uint64_t *a, const uint64_t *b){
+#ifdef BITSET_AVX2
+    if(__builtin_cpu_supports("avx2"))
+        return conta_comum_avx2(a, b, PALAVRAS(g));
+#endif
+    return conta_comum_64(a, b, PALAVRAS(g));
+}
+
+//------------------------------------------------------------------------------
+// devolve g->bits, lido de forma que uma matriz publicada por outra thread
+// (ver constroi_bitset()) seja vista já completa
+
+static uint64_t *bits_publicados(grafo g){
+#ifdef __GNUC__
+    return __atomic_load_n(&g->bits, __ATOMIC_ACQUIRE);
+#else
+    return g->bits;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// constrói a matriz de adjacência em bits de g (ver grafo.h)
+//
+// a matriz é montada à parte e só então publicada em g->bits; se outra
+// thread publicar a sua antes, esta é descartada
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int constroi_bitset(grafo g){
+    if(!g)
+        return 0;
+    if(bits_publicados(g) || g->n_vertices == 0)
+        return 1;
+
+    unsigned int palavras = PALAVRAS(g);
+    size_t tam = (size_t) g->n_vertices * palavras * sizeof(uint64_t);
+    void *memoria = NULL;
+
+    if(posix_memalign(&memoria, 32, tam) != 0)
+        return 0;
+    memset(memoria, 0, tam);
+
+    uint64_t *bits = memoria;
+    for(unsigned int u = 0; u < g->n_vertices; u++){
+        uint64_t *linha = bits + (size_t) u * palavras;
+        for(unsigned int j = g->inicio_saida[u]; j < g->inicio_saida[u+1]; j++)
+            LIGA_BIT(linha, g->alvo_saida[j]);
+    }
+
+#ifdef __GNUC__
+    uint64_t *esperado = NULL;
+    if(!__atomic_compare_exchange_n(&g->bits, &esperado, bits, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+        free(bits);
+#else
+    g->bits = bits;
+#endif
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve a matriz de bits que clique() e simplicial() devem usar em g,
+// construindo-a se g tem no máximo LIMITE_BITSET vertices, ou
+//         NULL se não há matriz
+//
+// quem chama usa sempre o apontador devolvido, e não g->bits, que pode
+// estar sendo publicado por outra thread
+
+static const uint64_t *usa_bitset(grafo g){
+    const uint64_t *bits = bits_publicados(g);
+
+    if(!bits && g->n_vertices <= LIMITE_BITSET && g->n_vertices > 0 && constroi_bitset(g))
+        bits = bits_publicados(g);
+    return bits;
+}
+
+//------------------------------------------------------------------------------
+// clique() com a matriz de bits: o conjunto vai para a linha auxiliar
+// a->conjunto, e cada vertice u dele precisa ter k-1 vizinhos no conjunto,
+// contados com um AND e um popcount por palavra
+
+static int clique_bitset(lista l, grafo g, const uint64_t *bits, area_trabalho a){
+    if(!reserva_conjunto(a, PALAVRAS(g)))
+        return 0;
+
+    uint64_t *conjunto = a->conjunto;
+    unsigned int k = 0;
+    int resultado = 1;
+
+    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
+        vertice v = conteudo(n);
+        if(!TEM_BIT(conjunto, v->id)){
+            LIGA_BIT(conjunto, v->id);
+            k++;
+        }
+    }
+
+    for (no n=primeiro_no(l); n!=NULL && resultado; n=proximo_no(n)) {
+        vertice u = conteudo(n);
+        const uint64_t *linha = LINHA(bits, g, u->id);
+        // um laço em u não conta como vizinho
+        if(conta_comum(g, linha, conjunto) - (unsigned int) TEM_BIT(linha, u->id) != k - 1)
+            resultado = 0;
+    }
+
+    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
+        vertice v = conteudo(n);
+        DESLIGA_BIT(conjunto, v->id);
+    }
+    return resultado;
+}
+
+//------------------------------------------------------------------------------
+// simplicial() com a matriz de bits: o conjunto é a própria linha de v, e
+// cada vizinho u de v precisa ter na sua linha os outros k-1 vizinhos de v
+
+static int simplicial_bitset(vertice v, grafo g, const uint64_t *bits){
+    const uint64_t *linha_v = LINHA(bits, g, v->id);
+    unsigned int laco_v = (unsigned int) TEM_BIT(linha_v, v->id);
+    unsigned int k = conta_comum(g, linha_v, linha_v) - laco_v;
+    cursor_vizinhos c;
+
+    inicia_vizinhos(&c, v, 0, g);
+    for(vertice u = proximo_vizinho(&c, NULL); u; u = proximo_vizinho(&c, NULL)){
+        if(u == v)
+            continue;
+        const uint64_t *linha_u = LINHA(bits, g, u->id);
+        // descontam-se u (se tem laço) e v (que só está no conjunto se tem laço)
+        if(conta_comum(g, linha_u, linha_v) - (unsigned int) TEM_BIT(linha_u, u->id) - laco_v != k - 1)
+            return 0;
+    }
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se u é vizinho dos outros k-1 vertices do conjunto marcado
+//            (a->marca[id] == membro) ou
+//         0, caso contrário
+//
+// cada vizinho de u no conjunto é contado uma só vez
+// (a->marca[a->capacidade+id] == visto); para assim que encontra os k-1, em
+// tempo O(grau(u))
+
+static int vizinho_de_todos(grafo g, area_trabalho a, vertice u, unsigned int k, unsigned int membro, unsigned int visto){
+    unsigned int *ja_visto = a->marca + a->capacidade;
+    unsigned int encontrados = 0;
+    cursor_vizinhos c;
+
+    if(k <= 1)
+        return 1;
+
+    inicia_vizinhos(&c, u, 0, g);
+    for(vertice w = proximo_vizinho(&c, NULL); w; w = proximo_vizinho(&c, NULL)){
+        if(w != u && a->marca[w->id] == membro && ja_visto[w->id] != visto){
+            ja_visto[w->id] = visto;
+            if(++encontrados == k - 1)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se o conjunto dos vertices em l é uma clique em g, ou
+//         0, caso contrário
+//
+// um conjunto C de vértices de um grafo é uma clique em g
+// se todo vértice em C é vizinho de todos os outros vértices de C em g
+//
+// usa os vetores auxiliares de a; o tempo é a soma dos graus dos vértices
+// de l
+
+int clique_area(lista l, grafo g, area_trabalho a){
+    if(!l || !g || !a)
+        return 0;
+    const uint64_t *bits = usa_bitset(g);
+    if(bits)
+        return clique_bitset(l, g, bits, a);
+
+    unsigned int membro = reserva_carimbos(a, g->n_vertices, tamanho_lista(l) + 1);
+    unsigned int visto = membro;
+    unsigned int k = 0;
+
+    if(!membro)
+        return 0;
+
+    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
+        vertice v = conteudo(n);
+        if(a->marca[v->id] != membro){
+            a->marca[v->id] = membro;
+            k++;
+        }
+    }
+
+    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n))
+        if(!vizinho_de_todos(g, a, conteudo(n), k, membro, ++visto))
+            return 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se o conjunto dos vertices em l é uma clique em g, ou
+//         0, caso contrário
+//
+// usa a área de trabalho da thread que chama
+
+int clique(lista l, grafo g){
+    return clique_area(l, g, area_da_thread());
+}
  
+//------------------------------------------------------------------------------
+// devolve 1, se v é um vértice simplicial em g, ou
+//         0, caso contrário
+//
+// um vértice é simplicial no grafo se sua vizinhança é uma clique
+//
+// usa os vetores auxiliares de a; o tempo é no máximo a soma dos graus dos
+// vizinhos de v
+ 
+int simplicial_area(vertice v, grafo g, area_trabalho a){
+    if(!v || !g || !a)
+        return 0;
+    const uint64_t *bits = usa_bitset(g);
+    if(bits)
+        return simplicial_bitset(v, g, bits);
+
+    unsigned int membro = reserva_carimbos(a, g->n_vertices, grau(v, 0, g) + 1);
+    unsigned int visto = membro;
+    unsigned int k = 0;
+    cursor_vizinhos c;
+
+    if(!membro)
+        return 0;
+
+    inicia_vizinhos(&c, v, 0, g);
+    for(vertice w = proximo_vizinho(&c, NULL); w; w = proximo_vizinho(&c, NULL)){
+        if(w != v && a->marca[w->id] != membro){
+            a->marca[w->id] = membro;
+            k++;
+        }
+    }
+
+    inicia_vizinhos(&c, v, 0, g);
+    for(vertice w = proximo_vizinho(&c, NULL); w; w = proximo_vizinho(&c, NULL))
+        if(w != v && !vizinho_de_todos(g, a, w, k, membro, ++visto))
+            return 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se v é um vértice simplicial em g, ou
+//         0, caso contrário
+//
+// usa a área de trabalho da thread que chama
+
+int simplicial(vertice v, grafo g){
+    return simplicial_area(v, g, area_da_thread());
+}
+//------------------------------------------------------------------------------
+// valor que indica "nenhum" vertice/classe nos vetores indexados por id
+
+#define NENHUM UINT_MAX
+
+//------------------------------------------------------------------------------
+// busca em largura lexicográfica por refinamento de partição, em tempo
+// O(|V|+|E|)
+//
+// os vertices ainda não visitados ficam em ordem[i+1 .. n-1], divididos em
+// classes contíguas de vertices com o mesmo rótulo, em ordem decrescente de
+// rótulo; a classe c ocupa ordem[cl_inicio[c] .. cl_inicio[c]+cl_tam[c]-1]
+// e classe[v] é a classe do vertice v
+//
+// ao visitar o vertice ordem[i], cada vizinho w ainda não visitado é movido
+// para o início da sua classe c, que é separada em duas: a parte com os
+// vizinhos (nova classe, logo antes de c, cl_nova[c]) e o resto de c; o
+// próximo vertice visitado é sempre o primeiro da primeira classe, ordem[i+1]
+//
+// como uma classe nova só é criada quando um vizinho é movido, e as classes
+// vazias são reaproveitadas, 2n classes bastam
+
+static int lexbfs_particao(grafo g, unsigned int *ordem, unsigned int *posicao){
+    unsigned int n = g->n_vertices;
+    unsigned int *classe = malloc(n * sizeof(unsigned int));
+    unsigned int *cl_inicio = malloc(2 * n * sizeof(unsigned int));
+    unsigned int *cl_tam = malloc(2 * n * sizeof(unsigned int));
+    unsigned int *cl_nova = malloc(2 * n * sizeof(unsigned int));
+    unsigned int *cl_criada = malloc(2 * n * sizeof(unsigned int)); // visita em que a classe foi criada, +1
+    unsigned int *livres = malloc(2 * n * sizeof(unsigned int)); // pilha de classes livres
+    unsigned int *tocadas = malloc(n * sizeof(unsigned int)); // classes separadas na visita atual
+    unsigned int n_livres = 0;
+    unsigned long long refinamentos = 0;
+    int ok = classe && cl_inicio && cl_tam && cl_nova && cl_criada && livres && tocadas;
+
+    if(ok){
+        for(unsigned int v = 0; v < n; v++){
+            ordem[v] = v;
+            posicao[v] = v;
+            classe[v] = 0;
+        }
+        cl_inicio[0] = 0;
+        cl_tam[0] = n;
+        cl_nova[0] = NENHUM;
+        cl_criada[0] = 0;
+        for(unsigned int c = 2 * n - 1; c > 0; c--)
+            livres[n_livres++] = c;
+
+        for(unsigned int i = 0; i < n; i++){
+            unsigned int v = ordem[i];
+            unsigned int c = classe[v];
+            unsigned int n_tocadas = 0;
+
+            // v é o primeiro vertice da primeira classe: sai dela
+            cl_inicio[c]++;
+            if(--cl_tam[c] == 0)
+                livres[n_livres++] = c;
+
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+
+                c = classe[w];
+                // já visitado, ou já movido nesta visita (aresta repetida)
+                if(posicao[w] <= i || cl_criada[c] == i + 1)
+                    continue;
+
+                if(cl_nova[c] == NENHUM){
+                    unsigned int nc = livres[--n_livres];
+                    cl_inicio[nc] = cl_inicio[c];
+                    cl_tam[nc] = 0;
+                    cl_nova[nc] = NENHUM;
+                    cl_criada[nc] = i + 1;
+                    cl_nova[c] = nc;
+                    tocadas[n_tocadas++] = c;
+                    refinamentos++;
+                }
+
+                // troca w com o primeiro vertice de c, que passa a ser o
+                // último da nova classe
+                unsigned int p = cl_inicio[c];
+                unsigned int u = ordem[p];
+                ordem[posicao[w]] = u;
+                posicao[u] = posicao[w];
+                ordem[p] = w;
+                posicao[w] = p;
+
+                cl_inicio[c]++;
+                cl_tam[c]--;
+                cl_tam[cl_nova[c]]++;
+                classe[w] = cl_nova[c];
+            }
+
+            for(unsigned int k = 0; k < n_tocadas; k++){
+                c = tocadas[k];
+                cl_nova[c] = NENHUM;
+                if(cl_tam[c] == 0)
+                    livres[n_livres++] = c;
+            }
+        }
+    }
+
+    free(classe);
+    free(cl_inicio);
+    free(cl_tam);
+    free(cl_nova);
+    free(cl_criada);
+    free(livres);
+    free(tocadas);
+    if(ok && instrumentado()){
+        soma_estatistica(E_REFINAMENTOS_LEXBFS, refinamentos);
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, g->inicio_saida[n]);
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// preenche ordem[0..n-1] com os ids dos vértices de g na ordem em que são
+// visitados por uma busca em largura lexicográfica, que começa pelo vertice
+// de id 0, e posicao[id] com a posição do vertice de id id em ordem
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int ordem_lexicografica(grafo g, unsigned int *ordem, unsigned int *posicao){
+    if(!g || !ordem || !posicao)
+        return 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    return lexbfs_particao(g, ordem, posicao);
+}
+
+//------------------------------------------------------------------------------
+// devolve uma lista de vertices com a ordem dos vértices dada por uma 
+// busca em largura lexicográfica
+//
+// o último vertice visitado é o primeiro da lista, de forma que a lista é
+// uma candidata a ordem perfeita de eliminação
+
+lista busca_largura_lexicografica(grafo g){
+    if(!g)
+        return NULL;
+
+    lista arvore = constroi_lista();
+    unsigned int *ordem = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int *posicao = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+
+    if(arvore && ordem && posicao && ordem_lexicografica(g, ordem, posicao))
+        for(unsigned int i = 0; i < g->n_vertices; i++)
+            insere_lista(g->vertices[ordem[i]], arvore);
+
+    free(ordem);
+    free(posicao);
+    return arvore;
+}
+//------------------------------------------------------------------------------
+// fila de prioridade por baldes: os vertices ainda não numerados ficam em
+// listas duplamente ligadas, uma por peso, e maximo (minimo) é um limite
+// superior (inferior) para o maior (menor) peso com algum vertice; quando os
+// pesos só crescem de 1 em 1, o custo total de achar o maior é proporcional
+// ao número de incrementos
+//
+// usada pela busca por cardinalidade máxima, pelo MCS-M e pela ordem de grau
+// mínimo
+
+struct baldes {
+    unsigned int *cabeca;   // primeiro vertice de cada peso, n posições
+    unsigned int *proximo;
+    unsigned int *anterior;
+    unsigned int *peso;
+    unsigned int maximo;
+    unsigned int minimo;
+};
+
+//------------------------------------------------------------------------------
+// põe os n vertices no balde de peso 0, com o de id 0 na frente
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int inicia_baldes(struct baldes *b, unsigned int n){
+    size_t tam = n ? n : 1;
+
+    b->cabeca = malloc(tam * sizeof(unsigned int));
+    b->proximo = malloc(tam * sizeof(unsigned int));
+    b->anterior = malloc(tam * sizeof(unsigned int));
+    b->peso = calloc(tam, sizeof(unsigned int));
+    b->maximo = b->minimo = 0;
+    if(!b->cabeca || !b->proximo || !b->anterior || !b->peso)
+        return 0;
+
+    for(unsigned int v = 0; v < n; v++){
+        b->cabeca[v] = NENHUM;
+        b->proximo[v] = v + 1 < n ? v + 1 : NENHUM;
+        b->anterior[v] = v > 0 ? v - 1 : NENHUM;
+    }
+    if(n > 0)
+        b->cabeca[0] = 0;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+
+static void libera_baldes(struct baldes *b){
+    free(b->cabeca);
+    free(b->proximo);
+    free(b->anterior);
+    free(b->peso);
+}
+
+//------------------------------------------------------------------------------
+// retira v do seu balde
+
+static void retira_balde(struct baldes *b, unsigned int v){
+    if(b->anterior[v] != NENHUM)
+        b->proximo[b->anterior[v]] = b->proximo[v];
+    else
+        b->cabeca[b->peso[v]] = b->proximo[v];
+    if(b->proximo[v] != NENHUM)
+        b->anterior[b->proximo[v]] = b->anterior[v];
+}
+
+//------------------------------------------------------------------------------
+// põe v, que não está em nenhum balde, na frente do balde de peso p (< n)
+
+static void poe_balde(struct baldes *b, unsigned int v, unsigned int p){
+    b->peso[v] = p;
+    b->anterior[v] = NENHUM;
+    b->proximo[v] = b->cabeca[p];
+    if(b->cabeca[p] != NENHUM)
+        b->anterior[b->cabeca[p]] = v;
+    b->cabeca[p] = v;
+    if(p > b->maximo)
+        b->maximo = p;
+    if(p < b->minimo)
+        b->minimo = p;
+}
+
+//------------------------------------------------------------------------------
+// aumenta em 1 o peso de v, que está num balde
+
+static void sobe_balde(struct baldes *b, unsigned int v){
+    retira_balde(b, v);
+    poe_balde(b, v, b->peso[v] + 1);
+}
+
+//------------------------------------------------------------------------------
+// devolve o primeiro vertice do balde de maior peso, sem retirá-lo, ou
+//         NENHUM se os baldes estão vazios
+
+static unsigned int maior_balde(struct baldes *b){
+    while(b->maximo > 0 && b->cabeca[b->maximo] == NENHUM)
+        b->maximo--;
+    return b->cabeca[b->maximo];
+}
+
+//------------------------------------------------------------------------------
+// devolve o primeiro vertice do balde de menor peso, sem retirá-lo, ou
+//         NENHUM se os baldes estão vazios
+//
+// maximo tem de ser um limite superior válido (poe_balde() o mantém)
+
+static unsigned int menor_balde(struct baldes *b){
+    while(b->minimo < b->maximo && b->cabeca[b->minimo] == NENHUM)
+        b->minimo++;
+    return b->cabeca[b->minimo];
+}
+
+//------------------------------------------------------------------------------
+// busca por cardinalidade máxima (Tarjan e Yannakakis), em tempo
+// O(|V|+|E|): o próximo vertice visitado é sempre um dos que têm mais
+// vizinhos já visitados, o primeiro do balde de maior peso
+//
+// o peso de cada vertice é o número de vizinhos distintos já visitados;
+// marca[w] == i indica que w já foi contado na visita i (aresta repetida)
+
+static int mcs_baldes(grafo g, unsigned int *ordem, unsigned int *posicao){
+    unsigned int n = g->n_vertices;
+    struct baldes b;
+    unsigned int *marca = malloc(n * sizeof(unsigned int));
+    int ok = inicia_baldes(&b, n) && marca;
+
+    if(ok){
+        for(unsigned int v = 0; v < n; v++){
+            posicao[v] = NENHUM;
+            marca[v] = NENHUM;
+        }
+        for(unsigned int i = 0; i < n; i++){
+            unsigned int v = maior_balde(&b);
+
+            retira_balde(&b, v);
+            ordem[i] = v;
+            posicao[v] = i;
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+                if(posicao[w] == NENHUM && marca[w] != i){
+                    marca[w] = i;
+                    sobe_balde(&b, w);
+                }
+            }
+        }
+    }
+
+    libera_baldes(&b);
+    free(marca);
+    if(ok && instrumentado())
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, g->inicio_saida[n]);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// preenche ordem[0..n-1] com os ids dos vértices de g na ordem em que são
+// visitados por uma busca por cardinalidade máxima, que começa pelo vertice
+// de id 0, e posicao[id] com a posição do vertice de id id em ordem
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int ordem_cardinalidade(grafo g, unsigned int *ordem, unsigned int *posicao){
+    if(!g || !ordem || !posicao)
+        return 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    return mcs_baldes(g, ordem, posicao);
+}
+
+//------------------------------------------------------------------------------
+// devolve uma lista de vertices com a ordem dos vértices dada por uma
+// busca por cardinalidade máxima
+//
+// como em busca_largura_lexicografica(), o último vertice visitado é o
+// primeiro da lista
+
+lista busca_cardinalidade_maxima(grafo g){
+    if(!g)
+        return NULL;
+
+    lista arvore = constroi_lista();
+    unsigned int *ordem = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int *posicao = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+
+    if(arvore && ordem && posicao && ordem_cardinalidade(g, ordem, posicao))
+        for(unsigned int i = 0; i < g->n_vertices; i++)
+            insere_lista(g->vertices[ordem[i]], arvore);
+
+    free(ordem);
+    free(posicao);
+    return arvore;
+}
+//------------------------------------------------------------------------------
+// teste de ordem perfeita de eliminação de Tarjan e Yannakakis, em tempo
+// O(|V|+|E|)
+//
+// ordem[i] é o id do i-ésimo vertice eliminado; pai[v] é o primeiro vizinho
+// de v eliminado depois dele. ordem é perfeita se, para todo v, os vizinhos
+// de v eliminados depois dele (exceto pai[v]) são vizinhos de pai[v]
+//
+// ao processar w = ordem[i], marca[u] = i para w e para cada vizinho u de w
+// já processado; assim, para cada vizinho v de w já processado, basta
+// verificar se pai[v] está marcado
+//
+// se a ordem não é perfeita e falha não é NULL, falha recebe os ids do
+// primeiro v encontrado assim, de pai[v] e de w: dois vizinhos de v,
+// eliminados depois dele, que não são vizinhos entre si
+
+static int verifica_eliminacao(grafo g, unsigned int *ordem, unsigned int *posicao, unsigned int *falha){
+    unsigned int n = g->n_vertices;
+    unsigned int *pai = malloc(n * sizeof(unsigned int));
+    unsigned int *marca = malloc(n * sizeof(unsigned int));
+    unsigned long long percorridas = 0;
+    int perfeita = pai && marca;
+
+    for(unsigned int i = 0; perfeita && i < n; i++){
+        unsigned int w = ordem[i];
+        unsigned int inicio = g->inicio_saida[w], fim = g->inicio_saida[w+1];
+
+        percorridas += fim - inicio;
+        pai[w] = w;
+        marca[w] = i;
+        for(unsigned int j = inicio; j < fim; j++){
+            unsigned int v = g->alvo_saida[j];
+            if(posicao[v] < i){
+                marca[v] = i;
+                if(pai[v] == v)
+                    pai[v] = w;
+            }
+        }
+        for(unsigned int j = inicio; j < fim; j++){
+            unsigned int v = g->alvo_saida[j];
+            if(posicao[v] < i && marca[pai[v]] != i){
+                perfeita = 0;
+                if(falha){
+                    falha[0] = v;
+                    falha[1] = pai[v];
+                    falha[2] = w;
+                }
+                break;
+            }
+        }
+    }
+
+    free(pai);
+    free(marca);
+    if(instrumentado())
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, percorridas);
+    return perfeita;
+}
+
+//------------------------------------------------------------------------------
+// preenche posicao[id] com a posição do vertice de id id em ordem[0..n-1]
+//
+// devolve 1, se ordem é uma permutação dos ids de g, ou
+//         0, caso contrário
+
+static int posicoes_da_ordem(grafo g, const unsigned int *ordem, unsigned int *posicao){
+    for(unsigned int v = 0; v < g->n_vertices; v++)
+        posicao[v] = NENHUM;
+    for(unsigned int i = 0; i < g->n_vertices; i++){
+        if(ordem[i] >= g->n_vertices || posicao[ordem[i]] != NENHUM)
+            return 0;
+        posicao[ordem[i]] = i;
+    }
     return 1;
 }
- 
+
+//------------------------------------------------------------------------------
+// inverte ordem[0..n-1] e atualiza posicao[] de acordo: o reverso da ordem
+// de visita da busca em largura lexicográfica é a ordem de eliminação
+
+static void inverte_ordem(unsigned int *ordem, unsigned int *posicao, unsigned int n){
+    for(unsigned int i = 0; i < n / 2; i++){
+        unsigned int t = ordem[i];
+        ordem[i] = ordem[n - 1 - i];
+        ordem[n - 1 - i] = t;
+    }
+    for(unsigned int i = 0; i < n; i++)
+        posicao[ordem[i]] = i;
+}
+
+//------------------------------------------------------------------------------
+// devolve um vetor (alocado) com os ids dos vértices da lista l, na ordem da
+// lista, ou
+//         NULL se l não tem n_vertices(g) vértices (ou em caso de erro)
+
+static unsigned int *ids_da_lista(lista l, grafo g){
+    if(tamanho_lista(l) != g->n_vertices)
+        return NULL;
+
+    unsigned int *ordem = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    if(!ordem)
+        return NULL;
+
+    unsigned int i = 0;
+    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
+        vertice v = conteudo(n);
+        ordem[i++] = v->id;
+    }
+    return ordem;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se ordem[0..n-1] (ids dos vértices, na ordem em que são
+//            eliminados) é uma ordem perfeita de eliminação para o grafo g ou
+//         0, caso contrário (inclusive se ordem não for uma permutação dos
+//            ids de g)
+
+int ordem_perfeita_eliminacao_id(grafo g, unsigned int *ordem){
+    if(!g || !ordem)
+        return 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int *posicao = malloc(g->n_vertices * sizeof(unsigned int));
+    int perfeita = posicao && posicoes_da_ordem(g, ordem, posicao)
+                   && verifica_eliminacao(g, ordem, posicao, NULL);
+
+    free(posicao);
+    return perfeita;
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se a lista l representa uma 
+//            ordem perfeita de eliminação para o grafo g ou
+//         0, caso contrário
+//
+// o tempo de execução é O(|V(G)|+|E(G)|)
+
+int ordem_perfeita_eliminacao(lista l, grafo g){
+    if(!l || !g)
+        return 0;
+    if(tamanho_lista(l) != g->n_vertices)
+        return 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int *ordem = ids_da_lista(l, g);
+    if(!ordem)
+        return 0;
+
+    int perfeita = ordem_perfeita_eliminacao_id(g, ordem);
+    free(ordem);
+    return perfeita;
+}
+//------------------------------------------------------------------------------
+// devolve 1, se g é um grafo cordal ou
+//         0, caso contrário
+//
+// o reverso da ordem da busca em largura lexicográfica, ou da busca por
+// cardinalidade máxima, é uma ordem perfeita de eliminação se e somente se
+// g é cordal
+
+int cordal_busca(grafo g, enum busca_eliminacao busca){
+    if(!g)
+        return 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int n = g->n_vertices;
+    unsigned int *ordem = malloc(n * sizeof(unsigned int));
+    unsigned int *posicao = malloc(n * sizeof(unsigned int));
+    int resultado = 0;
+    int medir = instrumentado();
+    unsigned long long instante = fim_fase(medir, E_NS_LEXBFS, 0);
+
+    if(medir)
+        soma_estatistica(E_TESTES_CORDAL, 1);
+    if(ordem && posicao && (busca == BUSCA_CARDINALIDADE ? mcs_baldes(g, ordem, posicao)
+                                                         : lexbfs_particao(g, ordem, posicao))){
+        instante = fim_fase(medir, E_NS_LEXBFS, instante);
+        inverte_ordem(ordem, posicao, n);
+        resultado = verifica_eliminacao(g, ordem, posicao, NULL);
+        fim_fase(medir, E_NS_VERIFICA_ELIMINACAO, instante);
+    }
+
+    free(ordem);
+    free(posicao);
+    return resultado;
+}
+
+//------------------------------------------------------------------------------
+
+int cordal(grafo g){
+    return cordal_busca(g, BUSCA_LEXICOGRAFICA);
+}
+
+//------------------------------------------------------------------------------
+// separa os vertices de g em dois lados (lado[id] = 0 ou 1) por uma busca em
+// largura a partir de cada componente, seguindo as vizinhanças de saída e de
+// entrada, em tempo O(|V|+|E|); fila e pai são vetores auxiliares de n
+// posições, e pai[id] fica sendo o vertice pelo qual id foi alcançado
+// (NENHUM para a raiz de cada busca)
+//
+// devolve NENHUM, se nenhuma aresta liga dois vertices do mesmo lado (g é
+//                 bipartido), ou
+//         o id de um vertice v com uma aresta {v,w} entre vertices do mesmo
+//         lado, com w em *outro; nesse caso a busca para no primeiro
+//         conflito e os lados ficam incompletos
+
+static unsigned int separa_lados(grafo g, unsigned int *lado, unsigned int *fila, unsigned int *pai, unsigned int *outro){
+    unsigned int n = g->n_vertices;
+    unsigned int conflito = NENHUM;
+    unsigned long long percorridas = 0;
+
+    for(unsigned int v = 0; v < n; v++)
+        lado[v] = NENHUM;
+
+    for(unsigned int r = 0; r < n; r++){
+        if(lado[r] != NENHUM)
+            continue;
+
+        unsigned int ini = 0, fim_fila = 0;
+        lado[r] = 0;
+        pai[r] = NENHUM;
+        fila[fim_fila++] = r;
+        while(ini < fim_fila){
+            unsigned int v = fila[ini++];
+            // num grafo não direcionado a vizinhança de entrada é a de saída
+            for(int sentido = 0; sentido < (g->direcionado ? 2 : 1); sentido++){
+                unsigned int *inicio = sentido ? g->inicio_entrada : g->inicio_saida;
+                unsigned int *alvo = sentido ? g->alvo_entrada : g->alvo_saida;
+                percorridas += inicio[v+1] - inicio[v];
+                for(unsigned int j = inicio[v]; j < inicio[v+1]; j++){
+                    unsigned int w = alvo[j];
+                    if(lado[w] == NENHUM){
+                        lado[w] = 1 - lado[v];
+                        pai[w] = v;
+                        fila[fim_fila++] = w;
+                    }
+                    else if(lado[w] == lado[v]){
+                        *outro = w;
+                        conflito = v;
+                        goto fim;
+                    }
+                }
+            }
+        }
+    }
+
+fim:
+    if(instrumentado())
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, percorridas);
+    return conflito;
+}
+
+//------------------------------------------------------------------------------
+// escreve em ciclo o ciclo ímpar formado pela aresta {v,w}, entre vertices
+// do mesmo lado, e pelos caminhos de v e de w até seu ancestral comum na
+// árvore da busca em largura de separa_lados(); auxiliar tem n posições
+//
+// v e w estão à mesma distância da raiz (a aresta entre eles não muda a
+// paridade e, numa busca em largura, as distâncias diferem de no máximo 1),
+// então basta subir pelos dois ao mesmo tempo até se encontrarem
+//
+// devolve o tamanho do ciclo (1 se v == w, um laço)
+
+static unsigned int ciclo_impar(unsigned int *pai, unsigned int v, unsigned int w,
+                                unsigned int *ciclo, unsigned int *auxiliar){
+    unsigned int k = 0;
+
+    while(v != w){
+        ciclo[k] = v;
+        auxiliar[k] = w;
+        k++;
+        v = pai[v];
+        w = pai[w];
+    }
+    // ciclo = v ... ancestral ... w, e a aresta {w,v} fecha o ciclo
+    ciclo[k] = v;
+    for(unsigned int i = 0; i < k; i++)
+        ciclo[k + 1 + i] = auxiliar[k - 1 - i];
+    return 2 * k + 1;
+}
+
+//------------------------------------------------------------------------------
+// verifica se g é bipartido (ver grafo.h), em tempo O(|V|+|E|)
+//
+// devolve 1, se g é bipartido, ou
+//         0, caso contrário (ou em caso de falta de memória, com
+//            *tamanho_ciclo == 0)
+
+int bipartido(grafo g, unsigned int *lado, unsigned int *ciclo, unsigned int *tamanho_ciclo){
+    if(!g || !lado)
+        return 0;
+    if(tamanho_ciclo)
+        *tamanho_ciclo = 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int *fila = malloc(g->n_vertices * sizeof(unsigned int));
+    unsigned int *pai = malloc(g->n_vertices * sizeof(unsigned int));
+    unsigned int w = NENHUM, v = NENHUM;
+
+    if(fila && pai){
+        v = separa_lados(g, lado, fila, pai, &w);
+        if(v != NENHUM && ciclo && tamanho_ciclo)
+            *tamanho_ciclo = ciclo_impar(pai, v, w, ciclo, fila);
+    }
+
+    int resultado = fila && pai && v == NENHUM;
+    free(fila);
+    free(pai);
+    return resultado;
+}
+
+//------------------------------------------------------------------------------
+// número de vizinhos de u considerando as arestas sem direção: os de saída
+// mais, num grafo direcionado, os de entrada (um vizinho ligado por arcos
+// nos dois sentidos aparece duas vezes)
+
+static unsigned int grau_sem_direcao(grafo g, unsigned int u){
+    unsigned int d = g->inicio_saida[u+1] - g->inicio_saida[u];
+
+    if(g->direcionado)
+        d += g->inicio_entrada[u+1] - g->inicio_entrada[u];
+    return d;
+}
+
+//------------------------------------------------------------------------------
+// devolve o k-ésimo (k < grau_sem_direcao(g, u)) vizinho de u considerando
+// as arestas sem direção: primeiro os de saída, depois os de entrada
+
+static unsigned int vizinho_sem_direcao(grafo g, unsigned int u, unsigned int k){
+    unsigned int saida = g->inicio_saida[u+1] - g->inicio_saida[u];
+
+    if(k < saida)
+        return g->alvo_saida[g->inicio_saida[u] + k];
+    return g->alvo_entrada[g->inicio_entrada[u] + k - saida];
+}
+
+//------------------------------------------------------------------------------
+// Hopcroft e Karp: emparelhamento máximo entre os vertices do lado 0 e os do
+// lado 1, em tempo O(|E|.sqrt(|V|)), considerando as arestas sem direção
+// (como separa_lados())
+//
+// par[id] é o id do vertice emparelhado com id, ou NENHUM; cada fase faz uma
+// busca em largura a partir dos vertices livres do lado 0, que calcula a
+// camada (dist) de cada um deles, e depois uma busca em profundidade por
+// caminhos aumentantes mínimos, disjuntos, que seguem as camadas
+//
+// a busca em profundidade é iterativa: pilha guarda os vertices do lado 0 do
+// caminho atual e atual[u] é a posição, entre os vizinhos de u numerados
+// por vizinho_sem_direcao(), da aresta de u sendo examinada
+
+static unsigned int hopcroft_karp(grafo g, unsigned int *lado, unsigned int *par){
+    unsigned int n = g->n_vertices;
+    unsigned int *dist = malloc(n * sizeof(unsigned int));
+    unsigned int *fila = malloc(n * sizeof(unsigned int));
+    unsigned int *atual = malloc(n * sizeof(unsigned int));
+    unsigned int *pilha = malloc(n * sizeof(unsigned int));
+    unsigned int tamanho = 0;
+    unsigned long long fases = 0, guloso = 0, percorridas = 0;
+
+    for(unsigned int v = 0; v < n; v++)
+        par[v] = NENHUM;
+
+    if(!dist || !fila || !atual || !pilha){
+        free(dist);
+        free(fila);
+        free(atual);
+        free(pilha);
+        return NENHUM;
+    }
+
+    // emparelhamento guloso inicial
+    for(unsigned int u = 0; u < n; u++){
+        if(lado[u] != 0)
+            continue;
+        unsigned int grau = grau_sem_direcao(g, u);
+        for(unsigned int k = 0; k < grau; k++){
+            unsigned int v = vizinho_sem_direcao(g, u, k);
+            if(lado[v] == 1 && par[v] == NENHUM){
+                par[u] = v;
+                par[v] = u;
+                tamanho++;
+                break;
+            }
+        }
+    }
+    guloso = tamanho;
+
+    for(;;){
+        // camadas
+        unsigned int ini = 0, fim_fila = 0, limite = NENHUM;
+        for(unsigned int u = 0; u < n; u++){
+            if(lado[u] == 0 && par[u] == NENHUM){
+                dist[u] = 0;
+                fila[fim_fila++] = u;
+            }
+            else
+                dist[u] = NENHUM;
+        }
+        while(ini < fim_fila){
+            unsigned int u = fila[ini++];
+            if(dist[u] >= limite)
+                break;
+            // num grafo não direcionado a vizinhança de entrada é a de saída
+            for(int sentido = 0; sentido < (g->direcionado ? 2 : 1); sentido++){
+                unsigned int *inicio = sentido ? g->inicio_entrada : g->inicio_saida;
+                unsigned int *alvo = sentido ? g->alvo_entrada : g->alvo_saida;
+                percorridas += inicio[u+1] - inicio[u];
+                for(unsigned int j = inicio[u]; j < inicio[u+1]; j++){
+                    unsigned int v = alvo[j];
+                    if(lado[v] != 1)
+                        continue;
+                    unsigned int w = par[v];
+                    if(w == NENHUM){
+                        if(limite == NENHUM)
+                            limite = dist[u] + 1;
+                    }
+                    else if(dist[w] == NENHUM){
+                        dist[w] = dist[u] + 1;
+                        fila[fim_fila++] = w;
+                    }
+                }
+            }
+        }
+        if(limite == NENHUM)
+            break;
+        fases++;
+
+        // caminhos aumentantes
+        for(unsigned int u = 0; u < n; u++)
+            atual[u] = 0;
+
+        for(unsigned int r = 0; r < n; r++){
+            if(lado[r] != 0 || par[r] != NENHUM || dist[r] != 0)
+                continue;
+
+            unsigned int topo = 0;
+            pilha[topo++] = r;
+            while(topo > 0){
+                unsigned int u = pilha[topo-1];
+
+                if(atual[u] == grau_sem_direcao(g, u)){
+                    // sem caminho a partir de u nesta fase
+                    dist[u] = NENHUM;
+                    if(--topo > 0)
+                        atual[pilha[topo-1]]++;
+                    continue;
+                }
+
+                unsigned int v = vizinho_sem_direcao(g, u, atual[u]);
+                unsigned int w = par[v];
+                percorridas++;
+                if(lado[v] != 1)
+                    atual[u]++;
+                else if(w == NENHUM && dist[u] + 1 == limite){
+                    // inverte o caminho pilha[0..topo-1]
+                    for(unsigned int k = topo; k > 0; k--){
+                        unsigned int a = pilha[k-1];
+                        unsigned int b = vizinho_sem_direcao(g, a, atual[a]);
+                        par[a] = b;
+                        par[b] = a;
+                    }
+                    tamanho++;
+                    topo = 0;
+                }
+                else if(w != NENHUM && dist[w] == dist[u] + 1 && dist[w] < limite)
+                    pilha[topo++] = w;
+                else
+                    atual[u]++;
+            }
+        }
+    }
+
+    free(dist);
+    free(fila);
+    free(atual);
+    free(pilha);
+    if(instrumentado()){
+        soma_estatistica(E_FASES_HOPCROFT_KARP, fases);
+        soma_estatistica(E_EMPARELHAMENTO_GULOSO, guloso);
+        soma_estatistica(E_CAMINHOS_AUMENTANTES, tamanho - guloso);
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, percorridas);
+    }
+    return tamanho;
+}
+
+//------------------------------------------------------------------------------
+// calcula um emparelhamento máximo no grafo bipartido g
+//
+// par[id] recebe o id do vértice emparelhado com id, ou UINT_MAX se id não
+// é coberto, e *tamanho recebe o número de arestas do emparelhamento
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário (inclusive se g não é bipartido)
+
+int emparelhamento_maximo_id(grafo g, unsigned int *par, unsigned int *tamanho){
+    if(!g || !par || !tamanho)
+        return 0;
+
+    *tamanho = 0;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int *lado = malloc(g->n_vertices * sizeof(unsigned int));
+    unsigned int *fila = malloc(g->n_vertices * sizeof(unsigned int));
+    unsigned int *pai = malloc(g->n_vertices * sizeof(unsigned int));
+    unsigned int w;
+    int medir = instrumentado();
+    unsigned long long t = fim_fase(medir, E_NS_BIPARTICAO, 0);
+    // se g não é bipartido, falha antes de emparelhar
+    int ok = lado && fila && pai && separa_lados(g, lado, fila, pai, &w) == NENHUM;
+
+    t = fim_fase(medir, E_NS_BIPARTICAO, t);
+    if(medir)
+        soma_estatistica(E_EMPARELHAMENTOS, 1);
+    if(ok){
+        *tamanho = hopcroft_karp(g, lado, par);
+        ok = *tamanho != NENHUM;
+        if(!ok)
+            *tamanho = 0;
+        fim_fase(medir, E_NS_HOPCROFT_KARP, t);
+    }
+
+    free(lado);
+    free(fila);
+    free(pai);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// devolve um grafo cujos vertices são cópias dos vertices de g cobertos pelo
+// emparelhamento par (ver emparelhamento_maximo_id()), de tamanho tamanho, e
+// cujas arestas são as arestas desse emparelhamento, com seus pesos; num
+// grafo direcionado, cada arco mantém o sentido que tem em g
+
+static grafo monta_emparelhamento(grafo g, const unsigned int *par, unsigned int tamanho){
+    int medir = instrumentado();
+    unsigned long long t = fim_fase(medir, E_NS_MONTA_EMPARELHAMENTO, 0);
+    grafo e = cria_grafo(g->nome, g->direcionado, g->ponderado, (int) (2 * tamanho));
+    if(!e)
+        return NULL;
+
+    for(unsigned int u = 0; u < g->n_vertices; u++){
+        if(par[u] == NENHUM || par[u] < u)
+            continue;
+
+        // procura o arco u -> par[u] e, se não há, o arco par[u] -> u
+        unsigned int de = u, para = par[u], j;
+        long int peso = 0;
+        for(j = g->inicio_saida[u]; j < g->inicio_saida[u+1] && g->alvo_saida[j] != par[u]; j++)
+            ;
+        if(j < g->inicio_saida[u+1])
+            peso = g->peso_saida[j];
+        else{
+            for(j = g->inicio_entrada[u]; j < g->inicio_entrada[u+1] && g->alvo_entrada[j] != par[u]; j++)
+                ;
+            if(j < g->inicio_entrada[u+1])
+                peso = g->peso_entrada[j];
+            de = par[u];
+            para = u;
+        }
+        vertice origem = cria_vertice(e, g->vertices[de]->nome);
+        vertice destino = cria_vertice(e, g->vertices[para]->nome);
+        cria_vizinhanca(e, origem, destino, peso);
+    }
+
+    congela_grafo(e);
+    fim_fase(medir, E_NS_MONTA_EMPARELHAMENTO, t);
+    return e;
+}
+
+//------------------------------------------------------------------------------
+// devolve um grafo cujos vertices são cópias de vértices do grafo
+// bipartido g e cujas arestas formam um emparelhamento máximo em g, ou
+//         NULL se g não é bipartido (ou em caso de erro)
+
+grafo emparelhamento_maximo(grafo g){
+    if(!g)
+        return NULL;
+
+    unsigned int *par = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int tamanho;
+    if(!par || !emparelhamento_maximo_id(g, par, &tamanho)){
+        free(par);
+        return NULL;
+    }
+
+    grafo e = monta_emparelhamento(g, par, tamanho);
+    free(par);
+    return e;
+}
+
+//------------------------------------------------------------------------------
+//GRAFOS CORDAIS
+//------------------------------------------------------------------------------
+// algoritmos que exploram uma ordem perfeita de eliminação de um grafo
+// cordal, dada por quem chama ou, se omitida, o reverso da busca em largura
+// lexicográfica (como em cordal()), em tempo O(|V|+|E|)
+//
+// se v = elimina[i], os vizinhos de v eliminados depois dele (posicao > i)
+// formam uma clique; toda clique maximal é um desses conjuntos mais v
+
+//------------------------------------------------------------------------------
+// preenche elimina[0..n-1] com ordem ou, se ordem é NULL, com o reverso da
+// busca em largura lexicográfica de g, e posicao[id] com a posição do
+// vertice de id id em elimina
+//
+// devolve 1, se elimina é uma ordem perfeita de eliminação para g, ou
+//         0, caso contrário (inclusive se ordem não é uma permutação dos ids
+//            de g, ou em caso de falta de memória)
+
+static int eliminacao_perfeita(grafo g, const unsigned int *ordem, unsigned int *elimina, unsigned int *posicao){
+    unsigned int n = g->n_vertices;
+
+    if(ordem){
+        memcpy(elimina, ordem, n * sizeof(unsigned int));
+        if(!posicoes_da_ordem(g, elimina, posicao))
+            return 0;
+    }
+    else{
+        if(!lexbfs_particao(g, elimina, posicao))
+            return 0;
+        inverte_ordem(elimina, posicao, n);
+    }
+    return verifica_eliminacao(g, elimina, posicao, NULL);
+}
+
 //------------------------------------------------------------------------------
-// escreve o grafo g em output usando o formato dot, de forma que
+// devolve o número de vizinhos distintos de v = elimina[i] eliminados
+// depois dele; marca[w] == carimbo indica que w já foi contado
+
+static unsigned int conta_posteriores(grafo g, unsigned int v, unsigned int i, const unsigned int *posicao,
+                                      unsigned int *marca, unsigned int carimbo){
+    unsigned int k = 0;
+
+    for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+        unsigned int w = g->alvo_saida[j];
+        if(posicao[w] > i && marca[w] != carimbo){
+            marca[w] = carimbo;
+            k++;
+        }
+    }
+    return k;
+}
+
+//------------------------------------------------------------------------------
+// escreve em ciclo um ciclo sem cordas formado por v, por dois vizinhos p e
+// w de v que não são vizinhos entre si e por um caminho mínimo de p a w que
+// não passa por v nem por outros vizinhos de v; fila e pai são vetores
+// auxiliares de n posições
 //
-// 1. todos os vértices são escritos antes de todas as arestas/arcos
+// o ciclo não tem cordas: v só é vizinho de p e de w, p e w não são
+// vizinhos e um caminho mínimo não tem atalhos; como p e w não são
+// vizinhos, o caminho tem pelo menos 2 arestas e o ciclo pelo menos 4
+// vertices
 //
-// 2. se uma aresta tem peso, este deve ser escrito como um atributo
-//    de nome "peso"
+// pai[x] == NENHUM indica que x ainda não foi alcançado e pai[x] == n que x
+// está fora da busca (v e seus vizinhos, exceto p e w)
 //
-// devolve o grafo escrito ou
-//         NULL em caso de erro
- 
-grafo escreve_grafo(FILE *output, grafo g){
-    if(!g || !output)
-        return NULL;
- 
-    Agraph_t *ag;
-    Agsym_t *peso;
- 
-    char peso_s[MAX_STRING_SIZE];
- 
-    //criando a string "peso"
-    char p_str[5];
-    strcpy(p_str, "peso");
- 
-    //cria uma string vazia pra usar como valor default do atributo peso
- 
-    char default_s[1];
-    default_s[0] = '\0';
- 
-    if(g->direcionado)
-        ag = agopen(g->nome, Agstrictdirected, NULL);
-    else
-        ag= agopen(g->nome, Agstrictundirected, NULL);
- 
-    if(g->ponderado)
-        peso = agattr(ag, AGEDGE, p_str, default_s);
- 
-    Agnode_t **nodes = malloc(g->n_vertices * sizeof(Agnode_t*));
-   
-    for(unsigned int i = 0; i < g->n_vertices; i++)
-        nodes[g->vertices[i]->id] = agnode(ag, g->vertices[i]->nome, TRUE);
- 
-    for(unsigned int i = 0; i < g->n_vertices; i++){
-        vertice v = g->vertices[i];
- 
-        for(no n = primeiro_no(v->adjacencias_saida); n != NULL; n = proximo_no(n)){
-            adjacencia viz = conteudo(n);
- 
-            Agedge_t *ae = agedge(ag, nodes[v->id], nodes[viz->v_destino->id], NULL, TRUE);
-               
-            if(g->ponderado){
-                sprintf(peso_s, "%ld", viz->peso);
-                agxset(ae, peso, peso_s);
+// devolve o tamanho do ciclo ou
+//         0 se não há caminho de p a w fora da vizinhança de v
+
+static unsigned int ciclo_sem_corda(grafo g, unsigned int v, unsigned int p, unsigned int w,
+                                    unsigned int *ciclo, unsigned int *fila, unsigned int *pai){
+    unsigned int n = g->n_vertices;
+    unsigned int ini = 0, fim_fila = 0;
+
+    for(unsigned int x = 0; x < n; x++)
+        pai[x] = NENHUM;
+    pai[v] = n;
+    for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++)
+        pai[g->alvo_saida[j]] = n;
+    pai[w] = NENHUM;
+    pai[p] = p;
+    fila[fim_fila++] = p;
+
+    while(ini < fim_fila && pai[w] == NENHUM){
+        unsigned int x = fila[ini++];
+        for(unsigned int j = g->inicio_saida[x]; j < g->inicio_saida[x+1]; j++){
+            unsigned int y = g->alvo_saida[j];
+            if(pai[y] == NENHUM){
+                pai[y] = x;
+                fila[fim_fila++] = y;
             }
         }
     }
- 
-    free(nodes);
-    agwrite(ag, output);
-    agclose(ag);
-    agfree(ag, NULL);
-    return g;
+    if(pai[w] == NENHUM)
+        return 0;
+
+    // ciclo = v, p, ..., w: o caminho é escrito de trás para a frente
+    unsigned int k = 1;
+    for(unsigned int x = w; x != p; x = pai[x])
+        k++;
+    ciclo[0] = v;
+    for(unsigned int x = w, i = k; ; x = pai[x]){
+        ciclo[i--] = x;
+        if(x == p)
+            break;
+    }
+    return k + 1;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve um grafo igual a g
- 
-grafo copia_grafo(grafo g){
+// verifica se g é cordal (ver grafo.h), com um ciclo sem cordas como
+// certificado quando não é, em tempo O(|V|+|E|)
+//
+// a ordem perfeita de eliminação candidata é o reverso da busca em largura
+// lexicográfica, como em cordal(); quando ela falha em v, com vizinhos p e
+// w eliminados depois de v e não vizinhos, p e w estão ligados por um
+// caminho fora da vizinhança de v (Tarjan e Yannakakis), que fecha com v um
+// ciclo sem cordas
+//
+// num grafo direcionado a busca só segue os arcos de saída e a falha da
+// ordem não garante um ciclo sem cordas, então não há certificado
+//
+// devolve 1, se g é cordal,
+//         0, caso contrário (ou em caso de falta de memória, com
+//            *tamanho_ciclo == 0), ou
+//        -1, se g é direcionado
+
+int cordal_ciclo(grafo g, unsigned int *ciclo, unsigned int *tamanho_ciclo){
     if(!g)
-        return NULL;
-   
-    grafo copy = cria_grafo(g->nome, g->direcionado, g->ponderado, (int)g->n_vertices);
- 
-    if(copy == NULL){
-        printf("Sem memoria para alocar.\n");
+        return 0;
+    if(tamanho_ciclo)
+        *tamanho_ciclo = 0;
+    if(g->direcionado)
+        return -1;
+    if(g->n_vertices == 0)
+        return 1;
+
+    unsigned int n = g->n_vertices;
+    unsigned int *ordem = malloc(n * sizeof(unsigned int));
+    unsigned int *posicao = malloc(n * sizeof(unsigned int));
+    unsigned int falha[3];
+    int ok = ordem && posicao && lexbfs_particao(g, ordem, posicao);
+    int perfeita = 0;
+
+    if(ok){
+        inverte_ordem(ordem, posicao, n);
+        perfeita = verifica_eliminacao(g, ordem, posicao, falha);
+        if(!perfeita && ciclo){
+            unsigned int t = ciclo_sem_corda(g, falha[0], falha[1], falha[2], ciclo, ordem, posicao);
+            if(tamanho_ciclo)
+                *tamanho_ciclo = t;
+        }
     }
-    else{
-        copy->n_vertices = g->n_vertices;
-        copy->n_arestas = g->n_arestas;
- 
-        for(unsigned int i = 0; i < g->n_vertices; i++){
-            copy->vertices[i] = g->vertices[i];
+
+    free(ordem);
+    free(posicao);
+    return ok && perfeita;
+}
+
+//------------------------------------------------------------------------------
+// clique máxima de um grafo cordal (ver grafo.h): a maior das cliques
+// {v} U {vizinhos de v eliminados depois dele}
+//
+// devolve o tamanho da clique ou
+//         0 em caso de erro
+
+unsigned int clique_maxima_id(grafo g, const unsigned int *ordem, unsigned int *clique){
+    if(!g || g->n_vertices == 0)
+        return 0;
+
+    unsigned int n = g->n_vertices;
+    unsigned int *elimina = malloc(n * sizeof(unsigned int));
+    unsigned int *posicao = malloc(n * sizeof(unsigned int));
+    unsigned int *marca = malloc(n * sizeof(unsigned int));
+    unsigned int tamanho = 0, melhor = 0;
+
+    if(elimina && posicao && marca && eliminacao_perfeita(g, ordem, elimina, posicao)){
+        for(unsigned int v = 0; v < n; v++)
+            marca[v] = NENHUM;
+        for(unsigned int i = 0; i < n; i++){
+            unsigned int k = conta_posteriores(g, elimina[i], i, posicao, marca, i) + 1;
+            if(k > tamanho){
+                tamanho = k;
+                melhor = i;
+            }
+        }
+
+        if(clique){
+            unsigned int v = elimina[melhor];
+            unsigned int k = 0;
+
+            clique[k++] = v;
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+                if(posicao[w] > melhor && marca[w] != n){
+                    marca[w] = n;
+                    clique[k++] = w;
+                }
+            }
         }
     }
-    return copy;
-    free(copy);
+
+    free(elimina);
+    free(posicao);
+    free(marca);
+    return tamanho;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve a vizinhança de entrada do vértice v
- 
-static lista vizinhanca_entrada(vertice v){
-    lista viz = constroi_lista();
-    for (no n=primeiro_no(v->adjacencias_entrada); n!=NULL; n=proximo_no(n)) {
-        adjacencia a = conteudo(n);
-        insere_lista(a->v_origem, viz);
-    }        
-    return viz;
+// devolve uma lista com os vértices de uma clique máxima do grafo cordal g
+// (ver grafo.h) ou
+//         NULL em caso de erro
+
+lista clique_maxima(lista l, grafo g){
+    if(!g)
+        return NULL;
+
+    unsigned int *ordem = NULL;
+    if(l && !(ordem = ids_da_lista(l, g)))
+        return NULL;
+
+    unsigned int *clique = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int tamanho = clique ? clique_maxima_id(g, ordem, clique) : 0;
+    lista resultado = NULL;
+
+    if(clique && (tamanho > 0 || g->n_vertices == 0) && (resultado = constroi_lista())){
+        for(unsigned int i = 0; i < tamanho; i++)
+            insere_lista(g->vertices[clique[i]], resultado);
+    }
+
+    free(ordem);
+    free(clique);
+    return resultado;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve a vizinhança de saída do vértice v
- 
-static lista vizinhanca_saida(vertice v){
-    lista viz = constroi_lista();
-    for (no n=primeiro_no(v->adjacencias_saida); n!=NULL; n=proximo_no(n)) {
-        if(n != NULL){
-            adjacencia a = conteudo(n);
-            insere_lista(a->v_destino, viz);
+// coloração ótima de um grafo cordal (ver grafo.h): os vértices são
+// coloridos do último eliminado para o primeiro, cada um com a menor cor que
+// não está nos vizinhos eliminados depois dele; como esses vizinhos formam
+// uma clique, a cor de v é no máximo o seu número, e a coloração usa
+// exatamente o tamanho da clique máxima de cores
+//
+// usada[c] == i indica que a cor c está num vizinho de elimina[i]; como os
+// vizinhos são uma clique, a busca pela menor cor livre examina no máximo
+// grau+1 cores
+//
+// devolve o número de cores ou
+//         0 em caso de erro
+
+unsigned int coloracao_otima_id(grafo g, const unsigned int *ordem, unsigned int *cor){
+    if(!g || !cor || g->n_vertices == 0)
+        return 0;
+
+    unsigned int n = g->n_vertices;
+    unsigned int *elimina = malloc(n * sizeof(unsigned int));
+    unsigned int *posicao = malloc(n * sizeof(unsigned int));
+    unsigned int *usada = malloc(n * sizeof(unsigned int));
+    unsigned int cores = 0;
+
+    if(elimina && posicao && usada && eliminacao_perfeita(g, ordem, elimina, posicao)){
+        for(unsigned int c = 0; c < n; c++)
+            usada[c] = NENHUM;
+        for(unsigned int i = n; i-- > 0; ){
+            unsigned int v = elimina[i];
+            unsigned int c = 0;
+
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+                if(posicao[w] > i)
+                    usada[cor[w]] = i;
+            }
+            while(usada[c] == i)
+                c++;
+            cor[v] = c;
+            if(c + 1 > cores)
+                cores = c + 1;
         }
-    }        
-    return viz;
+    }
+
+    free(elimina);
+    free(posicao);
+    free(usada);
+    return cores;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve a vizinhança do vértice v
+// árvore de cliques de um grafo cordal (ver grafo.h), em tempo O(|V|+|E|)
 //
-// se direcao == 0, v é um vértice de um grafo não direcionado
-//                  e a função devolve sua vizinhanca
+// os vertices são processados do último eliminado para o primeiro; para
+// v = elimina[i], seja madj(v) o conjunto dos vizinhos eliminados depois de
+// v e u (o pai de v) o primeiro deles a ser eliminado: madj(v) está contido
+// em {u} U madj(u), que está na clique de u
 //
-// se direcao == -1, v é um vértice de um grafo direcionado e a função
-//                   devolve sua vizinhanca de entrada
+// se madj(v) é igual à clique de u e u é o último vertice acrescentado a
+// ela (topo), a clique cresce com v; caso contrário, {v} U madj(v) é uma
+// clique nova, filha da clique de u, com separador madj(v)
 //
-// se direcao == 1, v é um vértice de um grafo direcionado e a função
-//                  devolve sua vizinhanca de saída
- 
-lista vizinhanca(vertice v, int direcao, grafo g){
-    if (!g)
+// assim cada clique c é o separador madj(primeiro[c]) seguido dos vertices
+// que a criaram ou estenderam (clique_de[v] == c), e é guardada nessa ordem
+
+arvore_cliques constroi_arvore_cliques(grafo g, const unsigned int *ordem){
+    if(!g)
         return NULL;
-   
-    if(direcao==-1)
-        return vizinhanca_entrada(v);
-    else if (direcao == 1 || direcao == 0)
-        return vizinhanca_saida(v);
-       
-    return NULL;
+
+    unsigned int n = g->n_vertices;
+    size_t tam_n = n ? n : 1;
+    arvore_cliques a = calloc(1, sizeof(struct arvore_cliques));
+    unsigned int *elimina = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *posicao = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *marca = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *clique_de = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *topo = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *primeiro = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *proximo = malloc(tam_n * sizeof(unsigned int));
+    int ok = a && elimina && posicao && marca && clique_de && topo && primeiro && proximo;
+
+    if(ok){
+        a->n_vertices = n;
+        a->inicio = malloc((tam_n + 1) * sizeof(unsigned int));
+        a->tamanho_separador = malloc(tam_n * sizeof(unsigned int));
+        a->pai = malloc(tam_n * sizeof(unsigned int));
+        a->inicio_vertice = calloc(tam_n + 1, sizeof(unsigned int));
+        ok = a->inicio && a->tamanho_separador && a->pai && a->inicio_vertice
+             && (n == 0 || eliminacao_perfeita(g, ordem, elimina, posicao));
+    }
+
+    // cliques, com seus pais e separadores, e o tamanho de cada uma em
+    // inicio[c+1]
+    unsigned int k = 0;
+    if(ok){
+        for(unsigned int v = 0; v < n; v++)
+            marca[v] = NENHUM;
+        for(unsigned int i = n; i-- > 0; ){
+            unsigned int v = elimina[i];
+            unsigned int m = 0, u = NENHUM;
+
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+                if(posicao[w] > i && marca[w] != i){
+                    marca[w] = i;
+                    m++;
+                    if(u == NENHUM || posicao[w] < posicao[u])
+                        u = w;
+                }
+            }
+
+            unsigned int c = u == NENHUM ? NENHUM : clique_de[u];
+            if(c != NENHUM && topo[c] == u && m == a->inicio[c+1]){
+                clique_de[v] = c;
+                topo[c] = v;
+                a->inicio[c+1]++;
+            }
+            else{
+                clique_de[v] = k;
+                topo[k] = v;
+                primeiro[k] = v;
+                a->pai[k] = c;
+                a->tamanho_separador[k] = m;
+                a->inicio[k+1] = m + 1;
+                k++;
+            }
+        }
+        a->n_cliques = k;
+        a->inicio[0] = 0;
+        for(unsigned int c = 0; c < k; c++)
+            a->inicio[c+1] += a->inicio[c];
+        a->membros = malloc((a->inicio[k] ? a->inicio[k] : 1) * sizeof(unsigned int));
+        a->cliques = malloc((a->inicio[k] ? a->inicio[k] : 1) * sizeof(unsigned int));
+        ok = a->membros && a->cliques;
+    }
+
+    // membros: o separador de cada clique e depois os seus vertices próprios,
+    // do primeiro ao topo (proximo[c] é a posição do próximo deles)
+    if(ok){
+        for(unsigned int v = 0; v < n; v++)
+            marca[v] = NENHUM;
+        for(unsigned int c = 0; c < k; c++){
+            unsigned int v = primeiro[c], i = posicao[v];
+            unsigned int p = a->inicio[c];
+
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+                unsigned int w = g->alvo_saida[j];
+                if(posicao[w] > i && marca[w] != c){
+                    marca[w] = c;
+                    a->membros[p++] = w;
+                }
+            }
+            proximo[c] = p;
+        }
+        for(unsigned int i = n; i-- > 0; ){
+            unsigned int v = elimina[i];
+            a->membros[proximo[clique_de[v]]++] = v;
+        }
+
+        // índice inverso: as cliques de cada vertice, em ordem crescente
+        for(unsigned int p = 0; p < a->inicio[k]; p++)
+            a->inicio_vertice[a->membros[p] + 1]++;
+        for(unsigned int v = 0; v < n; v++)
+            a->inicio_vertice[v+1] += a->inicio_vertice[v];
+        for(unsigned int v = 0; v < n; v++)
+            proximo[v] = a->inicio_vertice[v];
+        for(unsigned int c = 0; c < k; c++)
+            for(unsigned int p = a->inicio[c]; p < a->inicio[c+1]; p++)
+                a->cliques[proximo[a->membros[p]]++] = c;
+    }
+
+    free(elimina);
+    free(posicao);
+    free(marca);
+    free(clique_de);
+    free(topo);
+    free(primeiro);
+    free(proximo);
+    if(!ok){
+        destroi_arvore_cliques(a);
+        return NULL;
+    }
+    return a;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve o grau do vértice v
-// i
-// se direcao == 0, v é um vértice de um grafo não direcionado
-//                  e a função devolve seu grau
+// devolve o número de cliques de a que contêm o vertice de id v, com os
+// seus números em *cliques
+
+unsigned int cliques_com_vertice(arvore_cliques a, unsigned int v, const unsigned int **cliques){
+    if(!a || v >= a->n_vertices){
+        if(cliques)
+            *cliques = NULL;
+        return 0;
+    }
+    if(cliques)
+        *cliques = a->cliques + a->inicio_vertice[v];
+    return a->inicio_vertice[v+1] - a->inicio_vertice[v];
+}
+
+//------------------------------------------------------------------------------
+// devolve o tamanho do separador entre a clique c de a e a sua clique pai,
+// com os seus vertices em *separador
+
+unsigned int separador_clique(arvore_cliques a, unsigned int c, const unsigned int **separador){
+    if(!a || c >= a->n_cliques){
+        if(separador)
+            *separador = NULL;
+        return 0;
+    }
+    if(separador)
+        *separador = a->membros + a->inicio[c];
+    return a->tamanho_separador[c];
+}
+
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada por a
 //
-// se direcao == -1, v é um vértice de um grafo direcionado
-//                   e a função devolve seu grau de entrada
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int destroi_arvore_cliques(arvore_cliques a){
+    if(!a)
+        return 0;
+
+    free(a->inicio);
+    free(a->membros);
+    free(a->tamanho_separador);
+    free(a->pai);
+    free(a->inicio_vertice);
+    free(a->cliques);
+    free(a);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// triangulação mínima pelo algoritmo MCS-M (Berry, Blair, Heggernes e
+// Peyton), em tempo O(|V|.|E|)
 //
-// se direcao == 1, v é um vértice de um grafo direcionado
-//                  e a função devolve seu grau de saída
- 
-unsigned int grau(vertice v, int direcao, grafo g){
-    if (!g)
+// como na busca por cardinalidade máxima, cada passo numera (de n-1 para 0,
+// em elimina) o vertice v de maior peso ainda não numerado; antes disso,
+// aumenta o peso de todo vertice u não numerado alcançável a partir de v por
+// um caminho cujos vertices internos, não numerados, têm peso menor que o
+// de u, e acrescenta a aresta {v,u} se ela não existe
+//
+// os alcançáveis são achados por uma busca em que alcance[j] (uma pilha, em
+// cabeca_alcance[j] e seguinte[]) guarda os vertices alcançados por
+// caminhos cujo maior peso interno é j, processados em ordem crescente de j;
+// os vizinhos de v são alcançados diretamente e nunca geram preenchimento
+//
+// *preenchimento recebe as 2*(*tamanho) extremidades das arestas
+// acrescentadas, alocadas aqui
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int mcs_m(grafo g, unsigned int *elimina, unsigned int **preenchimento, unsigned int *tamanho){
+    unsigned int n = g->n_vertices;
+    size_t tam_n = n ? n : 1;
+    struct baldes b;
+    int ok = inicia_baldes(&b, n);
+    unsigned int *numerado = calloc(tam_n, sizeof(unsigned int));
+    unsigned int *marca = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *cabeca_alcance = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *seguinte = malloc(tam_n * sizeof(unsigned int));
+    unsigned int *sobe = malloc(tam_n * sizeof(unsigned int));
+    size_t capacidade = 2 * tam_n, usado = 0;
+    unsigned int *arestas = malloc(capacidade * sizeof(unsigned int));
+    unsigned long long percorridas = 0;
+
+    ok = ok && numerado && marca && cabeca_alcance && seguinte && sobe && arestas;
+    if(ok)
+        for(unsigned int v = 0; v < n; v++){
+            marca[v] = NENHUM;
+            cabeca_alcance[v] = NENHUM;
+        }
+
+    for(unsigned int i = n; ok && i-- > 0; ){
+        unsigned int v = maior_balde(&b);
+        unsigned int n_sobe = 0, maximo = b.maximo;
+
+        retira_balde(&b, v);
+        numerado[v] = 1;
+        marca[v] = i;
+        elimina[i] = v;
+
+        for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++){
+            unsigned int u = g->alvo_saida[j];
+            if(!numerado[u] && marca[u] != i){
+                marca[u] = i;
+                sobe[n_sobe++] = u;
+                seguinte[u] = cabeca_alcance[b.peso[u]];
+                cabeca_alcance[b.peso[u]] = u;
+            }
+        }
+        percorridas += g->inicio_saida[v+1] - g->inicio_saida[v];
+
+        for(unsigned int p = 0; p <= maximo; p++){
+            while(cabeca_alcance[p] != NENHUM){
+                unsigned int x = cabeca_alcance[p];
+                cabeca_alcance[p] = seguinte[x];
+                percorridas += g->inicio_saida[x+1] - g->inicio_saida[x];
+
+                for(unsigned int j = g->inicio_saida[x]; j < g->inicio_saida[x+1]; j++){
+                    unsigned int y = g->alvo_saida[j];
+                    if(numerado[y] || marca[y] == i)
+                        continue;
+
+                    marca[y] = i;
+                    unsigned int q = b.peso[y] > p ? b.peso[y] : p;
+                    if(b.peso[y] > p){
+                        sobe[n_sobe++] = y;
+                        if(usado + 2 > capacidade){
+                            unsigned int *maior = realloc(arestas, 2 * capacidade * sizeof(unsigned int));
+                            if(!maior){
+                                ok = 0;
+                                break;
+                            }
+                            arestas = maior;
+                            capacidade *= 2;
+                        }
+                        arestas[usado++] = v;
+                        arestas[usado++] = y;
+                    }
+                    seguinte[y] = cabeca_alcance[q];
+                    cabeca_alcance[q] = y;
+                }
+            }
+        }
+
+        for(unsigned int k = 0; k < n_sobe; k++)
+            sobe_balde(&b, sobe[k]);
+    }
+
+    libera_baldes(&b);
+    free(numerado);
+    free(marca);
+    free(cabeca_alcance);
+    free(seguinte);
+    free(sobe);
+    if(!ok){
+        free(arestas);
+        return 0;
+    }
+    if(instrumentado())
+        soma_estatistica(E_ARESTAS_PERCORRIDAS, percorridas);
+    *preenchimento = arestas;
+    *tamanho = (unsigned int) (usado / 2);
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// triangulação mínima de g (ver grafo.h), pelo MCS-M
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int triangulacao_minima(grafo g, unsigned int *ordem, unsigned int **preenchimento, unsigned int *tamanho){
+    if(!g || g->direcionado || !tamanho)
         return 0;
-    if(direcao < 0)
-        return v->grau_entrada;
+
+    unsigned int *elimina = ordem ? ordem : malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int *arestas = NULL;
+    int ok = elimina && mcs_m(g, elimina, &arestas, tamanho);
+
+    if(elimina != ordem)
+        free(elimina);
+    if(ok && preenchimento)
+        *preenchimento = arestas;
     else
-        return v->grau_saida;
+        free(arestas);
+    if(!ok)
+        *tamanho = 0;
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// devolve um grafo com os vertices e arestas de g e as arestas de
+// triangulacao_minima(), de peso 0, ou
+//         NULL em caso de erro
+//
+// cada aresta {u,w} de g aparece duas vezes no CSR, e é copiada a partir da
+// posição em que w > u; um laço aparece duas vezes na vizinhança do seu
+// vertice e é copiado uma vez
+
+grafo triangula_grafo(grafo g){
+    if(!g || g->direcionado || g->n_vertices > INT_MAX)
+        return NULL;
+
+    unsigned int n = g->n_vertices, k;
+    unsigned int *arestas;
+    if(!triangulacao_minima(g, NULL, &arestas, &k))
+        return NULL;
+
+    size_t m = (size_t) g->n_arestas + k;
+    unsigned int *origem = malloc((m ? m : 1) * sizeof(unsigned int));
+    unsigned int *destino = malloc((m ? m : 1) * sizeof(unsigned int));
+    long int *peso = malloc((m ? m : 1) * sizeof(long int));
+    grafo t = m <= UINT_MAX / 2 ? cria_grafo(g->nome, 0, g->ponderado, (int) n) : NULL;
+    int ok = origem && destino && peso && t && t->vertices && t->indice;
+    unsigned int e = 0;
+
+    for(unsigned int u = 0; ok && u < n; u++){
+        int laco = 0;
+        ok = cria_vertice(t, g->vertices[u]->nome) != NULL;
+        for(unsigned int j = g->inicio_saida[u]; j < g->inicio_saida[u+1]; j++){
+            unsigned int w = g->alvo_saida[j];
+            if(w > u || (w == u && (laco = !laco))){
+                origem[e] = u;
+                destino[e] = w;
+                peso[e] = g->peso_saida[j];
+                e++;
+            }
+        }
+    }
+    for(unsigned int i = 0; ok && i < k; i++){
+        origem[e] = arestas[2 * i];
+        destino[e] = arestas[2 * i + 1];
+        peso[e] = 0;
+        e++;
+    }
+    if(ok)
+        ok = monta_csr(t, e, origem, destino, peso);
+
+    free(arestas);
+    free(origem);
+    free(destino);
+    free(peso);
+    if(!ok){
+        if(t)
+            destroi_grafo(t);
+        return NULL;
+    }
+    return t;
 }
 
 //------------------------------------------------------------------------------
-//Encontra o vertice que foi removido do grafo
+//LARGURA DE ÁRVORE
+//------------------------------------------------------------------------------
+// ordens de eliminação heurísticas, de grau mínimo e de preenchimento
+// mínimo, para grafos não direcionados quaisquer: o jogo de eliminação é
+// simulado numa cópia das vizinhanças que recebe as arestas de
+// preenchimento, e o vertice eliminado a cada passo é o de menor grau (numa
+// fila por baldes) ou o que criaria menos arestas (num heap)
+//
+// a largura da ordem, o maior número de vizinhos de um vertice quando ele é
+// eliminado, é um limite superior para a largura de árvore do grafo
+
+struct jogo_eliminacao {
+    unsigned int **viz;         // vizinhos de cada vertice, inclusive já eliminados
+    unsigned int *tam;          // posições usadas de viz[v]
+    unsigned int *cap;          // capacidade de viz[v]
+    unsigned int *bloco;        // vizinhanças iniciais, sem repetições
+    unsigned char *proprio;     // 1 se viz[v] cresceu e foi alocado fora de bloco
+    unsigned int *posicao;      // posição de eliminação do vertice, ou NENHUM
+    unsigned int *novos;        // início, em viz[v], dos vizinhos acrescentados
+                                // na última eliminação de um vizinho de v
+    unsigned int *marca;
+    unsigned int carimbo;       // último carimbo usado em marca
+    unsigned int n;
+};
+
+//------------------------------------------------------------------------------
+// devolve um carimbo novo para j->marca, zerando as marcas quando o carimbo
+// dá a volta
 
-static unsigned int findRemoved(lista l){
-    unsigned int removed = 0 ;
-    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
-        vertice v = conteudo(n);
-        if(v->removido == 1){
-           removed ++;
-        }
+static unsigned int novo_carimbo(struct jogo_eliminacao *j){
+    if(++j->carimbo == 0){
+        memset(j->marca, 0, j->n * sizeof(unsigned int));
+        j->carimbo = 1;
     }
-    return removed;
+    return j->carimbo;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve 1, se o conjunto dos vertices em l é uma clique em g, ou
-//         0, caso contrário
+
+static void libera_jogo(struct jogo_eliminacao *j){
+    if(j->viz && j->proprio)
+        for(unsigned int v = 0; v < j->n; v++)
+            if(j->proprio[v])
+                free(j->viz[v]);
+    free(j->viz);
+    free(j->tam);
+    free(j->cap);
+    free(j->bloco);
+    free(j->proprio);
+    free(j->posicao);
+    free(j->novos);
+    free(j->marca);
+}
+
+//------------------------------------------------------------------------------
+// copia as vizinhanças de g para j, sem laços nem repetições
 //
-// um conjunto C de vértices de um grafo é uma clique em g
-// se todo vértice em C é vizinho de todos os outros vértices de C em g
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
 
-// faz um loop em cima de cada elemento da lista l      
-// para cada elemento pega sua vizinhaca
-// se a vizinhaca conter todos os elementos da lista l continua
-// se não conter retorna 0
-   
-int clique(lista l, grafo g){
-    unsigned int removed = findRemoved(l);
-    for (no n=primeiro_no(l); n!=NULL; n=proximo_no(n)) {
-        vertice v = conteudo(n);
-        if(v->removido == 0){  
-            lista vizinhos = vizinhanca(v,0,g);
-            unsigned int todos_nos = tamanho_lista(l) - removed - 1;
-            for (no auxN=primeiro_no(vizinhos); auxN!=NULL; auxN=proximo_no(auxN)) {
-                if(todos_nos == 0)
-                    break;
-                vertice auxV = conteudo(auxN);
-                if(auxV->removido == 0){
-                    for (no verifiyNode=primeiro_no(l); verifiyNode!=NULL; verifiyNode=proximo_no(verifiyNode)) {
-                        vertice verifyVertice = conteudo(verifiyNode);  
-                        if(verifyVertice->removido == 0){
-                            if(strcmp(verifyVertice->nome,auxV->nome) == 0){
-                                todos_nos--;
-                                break;
-                            }  
-                        }
-                    }
-                }
+static int inicia_jogo(struct jogo_eliminacao *j, grafo g){
+    unsigned int n = g->n_vertices;
+    size_t tam_n = n ? n : 1;
+
+    j->n = n;
+    j->carimbo = 0;
+    j->bloco = NULL;
+    j->viz = malloc(tam_n * sizeof(unsigned int *));
+    j->tam = calloc(tam_n, sizeof(unsigned int));
+    j->cap = malloc(tam_n * sizeof(unsigned int));
+    j->proprio = calloc(tam_n, 1);
+    j->posicao = malloc(tam_n * sizeof(unsigned int));
+    j->novos = malloc(tam_n * sizeof(unsigned int));
+    j->marca = calloc(tam_n, sizeof(unsigned int));
+    if(!j->viz || !j->tam || !j->cap || !j->proprio || !j->posicao || !j->novos || !j->marca)
+        return 0;
+
+    // primeiro conta os vizinhos distintos, depois os copia
+    size_t total = 0;
+    for(unsigned int v = 0; v < n; v++){
+        unsigned int c = novo_carimbo(j);
+        j->marca[v] = c;
+        for(unsigned int k = g->inicio_saida[v]; k < g->inicio_saida[v+1]; k++){
+            unsigned int w = g->alvo_saida[k];
+            if(j->marca[w] != c){
+                j->marca[w] = c;
+                j->tam[v]++;
             }
-            if(todos_nos != 0){
-                return 0;
+        }
+        total += j->tam[v];
+    }
+
+    j->bloco = malloc((total ? total : 1) * sizeof(unsigned int));
+    if(!j->bloco)
+        return 0;
+
+    unsigned int *p = j->bloco;
+    for(unsigned int v = 0; v < n; v++){
+        unsigned int c = novo_carimbo(j);
+        j->viz[v] = p;
+        j->cap[v] = j->tam[v];
+        j->posicao[v] = NENHUM;
+        j->marca[v] = c;
+        for(unsigned int k = g->inicio_saida[v]; k < g->inicio_saida[v+1]; k++){
+            unsigned int w = g->alvo_saida[k];
+            if(j->marca[w] != c){
+                j->marca[w] = c;
+                *p++ = w;
             }
         }
-    }  
+    }
     return 1;
 }
- 
+
 //------------------------------------------------------------------------------
-// devolve 1, se v é um vértice simplicial em g, ou
-//         0, caso contrário
-//
-// um vértice é simplicial no grafo se sua vizinhança é uma clique
- 
-int simplicial(vertice v, grafo g){      
-    lista vizinhos = vizinhanca(v,0,g);    
-    return clique(vizinhos,g);
+// retira de viz[v] os vertices já eliminados
+
+static void compacta_vizinhos(struct jogo_eliminacao *j, unsigned int v){
+    unsigned int *viz = j->viz[v];
+    unsigned int k = 0;
+
+    for(unsigned int p = 0; p < j->tam[v]; p++)
+        if(j->posicao[viz[p]] == NENHUM)
+            viz[k++] = viz[p];
+    j->tam[v] = k;
 }
+
 //------------------------------------------------------------------------------
-// Gera o rotulo para o vertice v
-static void generateNumberRotule(vertice v, unsigned int rotulo){
-    
-    v->rotulo = realloc (v->rotulo,sizeof(unsigned int)* (unsigned int)(v->tamRotulo+1));
-    v->rotulo[v->tamRotulo] = rotulo;
-    v->tamRotulo+=1;
+// acrescenta w a viz[v], que dobra de tamanho quando enche
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
 
+static int acrescenta_vizinho(struct jogo_eliminacao *j, unsigned int v, unsigned int w){
+    if(j->tam[v] == j->cap[v]){
+        unsigned int cap = j->cap[v] < 4 ? 8 : 2 * j->cap[v];
+        unsigned int *viz;
+
+        if(j->proprio[v])
+            viz = realloc(j->viz[v], cap * sizeof(unsigned int));
+        else if((viz = malloc(cap * sizeof(unsigned int))))
+            memcpy(viz, j->viz[v], j->tam[v] * sizeof(unsigned int));
+        if(!viz)
+            return 0;
+        j->viz[v] = viz;
+        j->cap[v] = cap;
+        j->proprio[v] = 1;
+    }
+    j->viz[v][j->tam[v]++] = w;
+    return 1;
 }
+
 //------------------------------------------------------------------------------
-// Retorna uma lista de maiores lexicos, se nao houver retorna uma lista vazia
+// elimina v (na posição i), ligando entre si os seus vizinhos ainda não
+// eliminados e somando a *preenchimento o número de arestas acrescentadas;
+// depois disso viz[v] tem exatamente esses vizinhos, tam[] o grau de cada
+// um deles no grafo de eliminação e novos[] o início dos acrescentados
+//
+// devolve o número de vizinhos de v ou
+//         NENHUM em caso de falta de memória
 
-static lista findMaior(int posicao, unsigned int maiorRotulo, grafo g){
-    lista lexicos = constroi_lista();
+static unsigned int elimina_vertice(struct jogo_eliminacao *j, unsigned int v, unsigned int i,
+                                    unsigned int *preenchimento){
+    j->posicao[v] = i;
+    compacta_vizinhos(j, v);
 
-    for(unsigned int i=0; i < g->n_vertices; i++){
-        if(g->vertices[i]->passado!=1 && g->vertices[i]->rotulo!=NULL){
-            if(posicao < g->vertices[i]->tamRotulo){
+    unsigned int d = j->tam[v];
+    unsigned int *nv = j->viz[v];
+    unsigned int acrescentadas = 0;
 
-                if(g->vertices[i]->rotulo[posicao] > maiorRotulo){
-                    destroi_lista(lexicos, NULL);
-                    lexicos = constroi_lista();
-                    insere_lista(g->vertices[i],lexicos);
-                    maiorRotulo = g->vertices[i]->rotulo[posicao];
-                }
-                else if(g->vertices[i]->rotulo[posicao] == maiorRotulo){
-                    insere_lista(g->vertices[i],lexicos);  
-                }
+    for(unsigned int p = 0; p < d; p++){
+        unsigned int a = nv[p];
+        unsigned int c = novo_carimbo(j);
+
+        compacta_vizinhos(j, a);
+        j->novos[a] = j->tam[a];
+        for(unsigned int k = 0; k < j->tam[a]; k++)
+            j->marca[j->viz[a][k]] = c;
+        for(unsigned int q = 0; q < d; q++){
+            unsigned int b = nv[q];
+            if(b != a && j->marca[b] != c){
+                if(!acrescenta_vizinho(j, a, b))
+                    return NENHUM;
+                acrescentadas++;
             }
         }
     }
 
-    return lexicos;
-    free(lexicos);
+    // cada aresta nova {a,b} foi acrescentada a viz[a] e a viz[b]
+    *preenchimento += acrescentadas / 2;
+    return d;
 }
+
 //------------------------------------------------------------------------------
-// Retorna o vertice lexico
+// devolve o número de arestas que faltam entre os vizinhos do vertice x
+// ainda não eliminado, as que a eliminação de x acrescentaria
 
-static vertice findLexico(grafo g){
-        unsigned int maior = 0;
-        int notFinished = 1;
-        int k = 0;
-        lista result;
+static unsigned long long conta_preenchimento(struct jogo_eliminacao *j, unsigned int x){
+    compacta_vizinhos(j, x);
 
-        vertice v = NULL;
+    unsigned long long d = j->tam[x], arestas = 0;
+    unsigned int c = novo_carimbo(j);
 
-        while(notFinished){
-            result = findMaior(k,maior,g);
-            unsigned int tamResult = (unsigned int) tamanho_lista(result);
-            if(tamResult == 0){
-                notFinished = 0;            
-            }
-            else{
-                no verticeNo=primeiro_no(result);
-                v = conteudo(verticeNo);
-            }
-            k++;
+    for(unsigned int p = 0; p < j->tam[x]; p++)
+        j->marca[j->viz[x][p]] = c;
+    for(unsigned int p = 0; p < j->tam[x]; p++){
+        unsigned int a = j->viz[x][p];
+        for(unsigned int k = 0; k < j->tam[a]; k++){
+            unsigned int w = j->viz[a][k];
+            if(j->posicao[w] == NENHUM && j->marca[w] == c)
+                arestas++;
         }
-
-        return v;
-	free(result);
+    }
+    return d * (d - (d > 0)) / 2 - arestas / 2;
 }
+
+//------------------------------------------------------------------------------
+// heap binário de vertices pela chave (número de arestas de preenchimento),
+// com os empates decididos pelo menor id; lugar[v] é a posição de v em item,
+// ou NENHUM
+
+struct heap_eliminacao {
+    unsigned int *item;
+    unsigned int *lugar;
+    unsigned long long *chave;
+    unsigned int tamanho;
+    int padding; // só pra evitar warning
+};
+
 //------------------------------------------------------------------------------
-// Rotula a vizinhaca do vertice raiz passado por parametro.
-static void rotulaVizinhaca(vertice raiz, grafo g){
-    lista vizinhos = vizinhanca(raiz,0,g);    
-    for (no n=primeiro_no(vizinhos); n!=NULL; n=proximo_no(n)) {
-        unsigned int rotuloRaiz = raiz->rotulo[0];
-        
-        vertice auxV = conteudo(n);
-        generateNumberRotule(auxV,rotuloRaiz-1);
-    }  
-    free(vizinhos);
+
+static int antes_no_heap(struct heap_eliminacao *h, unsigned int x, unsigned int y){
+    return h->chave[x] < h->chave[y] || (h->chave[x] == h->chave[y] && x < y);
 }
 
 //------------------------------------------------------------------------------
-// devolve uma lista de vertices com a ordem dos vértices dada por uma 
-// busca em largura lexicográfica
+// restaura a ordem do heap a partir da posição k, subindo ou descendo
 
-lista busca_largura_lexicografica(grafo g){
-    lista arvore = constroi_lista();
-    int naoTerminou=1;
-    if(g->vertices!=NULL){
-        unsigned int rotulo = g->n_vertices;
-        vertice raiz = g->vertices[0];
-        generateNumberRotule(raiz,rotulo);
-        rotulaVizinhaca(raiz,g);
-        raiz->passado = 1;
-        insere_lista(raiz, arvore);
-        while(naoTerminou){
-            vertice lexico = findLexico(g);
-            if(lexico!=NULL){
-                rotulaVizinhaca(lexico,g);
-                insere_lista(lexico, arvore);
-                lexico->passado = 1;
-            }
-            else{
-                naoTerminou = 0;
-            }
+static void ajusta_heap(struct heap_eliminacao *h, unsigned int k){
+    unsigned int v = h->item[k];
 
-        }
+    while(k > 0 && antes_no_heap(h, v, h->item[(k - 1) / 2])){
+        h->item[k] = h->item[(k - 1) / 2];
+        h->lugar[h->item[k]] = k;
+        k = (k - 1) / 2;
     }
-
-    return arvore;
-    free(arvore);
+    for(;;){
+        unsigned int f = 2 * k + 1;
+        if(f >= h->tamanho)
+            break;
+        if(f + 1 < h->tamanho && antes_no_heap(h, h->item[f + 1], h->item[f]))
+            f++;
+        if(!antes_no_heap(h, h->item[f], v))
+            break;
+        h->item[k] = h->item[f];
+        h->lugar[h->item[k]] = k;
+        k = f;
+    }
+    h->item[k] = v;
+    h->lugar[v] = k;
 }
+
 //------------------------------------------------------------------------------
-// Procura o vertice v da vizinhaca de AuxN na lista léxica e retorna a posição dele em relação ao auxN.
+// retira e devolve o primeiro vertice do heap (que não pode estar vazio)
 
-static int leftPosition (vertice w, no auxN){
-    int index = 0;
-    for(no auxViz=proximo_no(auxN); auxViz!=NULL; auxViz=proximo_no(auxViz)){
-        vertice v = conteudo(auxViz);
-        if(strcmp(w->nome,v->nome) == 0){
-            return index;
-        }
-        index++;
+static unsigned int retira_heap(struct heap_eliminacao *h){
+    unsigned int v = h->item[0];
+
+    h->lugar[v] = NENHUM;
+    if(--h->tamanho > 0){
+        h->item[0] = h->item[h->tamanho];
+        ajusta_heap(h, 0);
     }
-    return -1;
+    return v;
 }
 
 //------------------------------------------------------------------------------
-// devolve 1, se a lista l representa uma 
-//            ordem perfeita de eliminação para o grafo g ou
-//         0, caso contrário
+// ordem de eliminação de grau mínimo ou, se por_preenchimento, de
+// preenchimento mínimo (ver grafo.h)
 //
-// o tempo de execução é O(|V(G)|+|E(G)|)
+// depois de eliminar v, só mudam o grau e o preenchimento dos vizinhos de
+// v e, se alguma aresta foi acrescentada, o preenchimento dos vizinhos
+// comuns das extremidades das arestas novas; o preenchimento é atualizado
+// pela diferença, sem recontar as arestas entre os vizinhos, e passo[x] == i
+// indica que x é vizinho do vertice eliminado no passo i
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
 
-int ordem_perfeita_eliminacao(lista l, grafo g){
-	
-    for (no auxN=primeiro_no(l); auxN!=NULL; auxN=proximo_no(auxN)) {
-        int menor = -1;
-        vertice v = conteudo(auxN);
-        
-        vertice w = NULL;
-        lista vizinhos = vizinhanca(v,0,g);
-        for(no auxViz=primeiro_no(vizinhos); auxViz!=NULL; auxViz=proximo_no(auxViz)){
-            vertice auxRight = conteudo(auxViz);
-            if(auxRight->removido==0){
-               int index = leftPosition(auxRight, auxN);
-               if(((menor==-1 ) || (index < menor)) && index>=0){
-                    menor = index;
-                    w = auxRight;
-               }
+static int eliminacao_heuristica(grafo g, int por_preenchimento, unsigned int *ordem,
+                                 unsigned int *largura, unsigned int *preenchimento){
+    unsigned int n = g->n_vertices;
+    size_t tam_n = n ? n : 1;
+    struct jogo_eliminacao j;
+    struct baldes b = { NULL, NULL, NULL, NULL, 0, 0 };
+    struct heap_eliminacao h = { NULL, NULL, NULL, 0, 0 };
+    unsigned int *passo = malloc(tam_n * sizeof(unsigned int));
+    int ok = inicia_jogo(&j, g) && passo;
+
+    *largura = 0;
+    *preenchimento = 0;
+    if(ok && por_preenchimento){
+        h.item = malloc(tam_n * sizeof(unsigned int));
+        h.lugar = malloc(tam_n * sizeof(unsigned int));
+        h.chave = malloc(tam_n * sizeof(unsigned long long));
+        ok = h.item && h.lugar && h.chave;
+        for(unsigned int v = 0; ok && v < n; v++){
+            h.chave[v] = conta_preenchimento(&j, v);
+            h.item[v] = v;
+            h.tamanho = v + 1;
+            ajusta_heap(&h, v);
+            passo[v] = NENHUM;
+        }
+    }
+    else if(ok){
+        ok = inicia_baldes(&b, n);
+        for(unsigned int v = 0; ok && v < n; v++){
+            retira_balde(&b, v);
+            poe_balde(&b, v, j.tam[v]);
+        }
+    }
+
+    for(unsigned int i = 0; ok && i < n; i++){
+        unsigned int v = por_preenchimento ? retira_heap(&h) : menor_balde(&b);
+        unsigned int antes = *preenchimento;
+
+        if(!por_preenchimento)
+            retira_balde(&b, v);
+        unsigned int d = elimina_vertice(&j, v, i, preenchimento);
+        if(d == NENHUM){
+            ok = 0;
+            break;
+        }
+        if(d > *largura)
+            *largura = d;
+        if(ordem)
+            ordem[i] = v;
+
+        if(!por_preenchimento){
+            for(unsigned int p = 0; p < d; p++){
+                unsigned int a = j.viz[v][p];
+                retira_balde(&b, a);
+                poe_balde(&b, a, j.tam[a]);
             }
+            continue;
         }
 
-        if(w!=NULL){
-            lista vizinhosW = vizinhanca(w,0,g);
-            int notFound;
-            for(no auxVizV=primeiro_no(vizinhos); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-                vertice auxV = conteudo(auxVizV);
-                if(strcmp(auxV->nome,w->nome) != 0 && auxV->removido == 0){
-                    
-                    notFound = 1;
-                    for(no auxVizW=primeiro_no(vizinhosW); auxVizW!=NULL; auxVizW=proximo_no(auxVizW)){
-                       vertice auxW = conteudo(auxVizW);
-                       
-                       if(strcmp(auxW->nome,auxV->nome) == 0){
-                           notFound = 0;
-                           break;
-                        }
+        for(unsigned int p = 0; p < d; p++)
+            passo[j.viz[v][p]] = i;
+
+        // fora de N[v], um vertice x só perde, do seu preenchimento, as
+        // arestas novas {a,w} com a e w vizinhos de x; cada aresta nova é
+        // vista a partir da extremidade de menor id
+        for(unsigned int p = 0; *preenchimento > antes && p < d; p++){
+            unsigned int a = j.viz[v][p];
+            if(j.novos[a] == j.tam[a])
+                continue;
+
+            unsigned int c = novo_carimbo(&j);
+            for(unsigned int k = 0; k < j.tam[a]; k++)
+                j.marca[j.viz[a][k]] = c;
+            for(unsigned int k = j.novos[a]; k < j.tam[a]; k++){
+                unsigned int w = j.viz[a][k];
+                if(w < a)
+                    continue;
+                for(unsigned int q = 0; q < j.tam[w]; q++){
+                    unsigned int x = j.viz[w][q];
+                    if(j.marca[x] == c && passo[x] != i){
+                        h.chave[x]--;
+                        ajusta_heap(&h, h.lugar[x]);
                     }
-                    if(notFound)
-                        return 0;
                 }
             }
-            v->removido=1;
         }
-    }
-    return 1;
-}
-//------------------------------------------------------------------------------
-// devolve 1, se g é um grafo cordal ou
-//         0, caso contrário
 
-int cordal(grafo g){
-    grafo copy = copia_grafo(g);
-    lista lexica = busca_largura_lexicografica(copy);
-    return ordem_perfeita_eliminacao(lexica,copy);
-    free(copy);
-    free(lexica);
-}
-
-//------------------------------------------------------------------------------
-//Adiciona os vertices a uma das duas partições
-
-static int adicionaConjunto(lista conjOrigem, lista conjDestino, grafo g){
-    int terminado = 1;
-
-    for(no pai=primeiro_no(conjOrigem); pai!=NULL; pai=proximo_no(pai)){
-        vertice auxV = conteudo(pai);
-        if(auxV->passado == 0){
-            terminado = 0;
-            auxV->passado = 1;
-            lista filhos = vizinhanca(auxV,0,g);
-            for(no filho=primeiro_no(filhos); filho!=NULL; filho=proximo_no(filho)){
-                vertice auxVa = conteudo(filho);
-                if(auxVa->inSet != 1){
-                    insere_lista(auxVa,conjDestino);        
-                    auxVa->inSet = 1;
-                }
-            }       
+        // um vizinho a de v perde os pares (v,y) com y fora de N[v] e as
+        // arestas novas entre seus vizinhos antigos, e ganha os pares de
+        // cada vizinho novo com os vizinhos de a que não são vizinhos dele
+        for(unsigned int p = 0; p < d; p++){
+            unsigned int a = j.viz[v][p];
+            unsigned int antigo = novo_carimbo(&j), recente = novo_carimbo(&j);
+            if(recente < antigo)
+                antigo = novo_carimbo(&j); // o carimbo deu a volta
+
+            unsigned long long perde = j.tam[a] + 1 - d, dentro = 0, ganha = 0;
+            for(unsigned int k = 0; k < j.tam[a]; k++)
+                j.marca[j.viz[a][k]] = k < j.novos[a] ? antigo : recente;
+            for(unsigned int k = 0; k < j.novos[a]; k++){
+                unsigned int y = j.viz[a][k];
+                if(passo[y] == i)
+                    for(unsigned int q = j.novos[y]; q < j.tam[y]; q++)
+                        dentro += j.marca[j.viz[y][q]] == antigo;
+            }
+            for(unsigned int k = j.novos[a]; k < j.tam[a]; k++){
+                unsigned int w = j.viz[a][k], comuns = 0;
+                for(unsigned int q = 0; q < j.tam[w]; q++)
+                    comuns += j.marca[j.viz[w][q]] == antigo || j.marca[j.viz[w][q]] == recente;
+                ganha += j.tam[a] - 1 - comuns;
+            }
+            h.chave[a] = h.chave[a] + ganha - perde - dentro / 2;
+            ajusta_heap(&h, h.lugar[a]);
         }
     }
 
-    return terminado;
+    libera_jogo(&j);
+    libera_baldes(&b);
+    free(h.item);
+    free(h.lugar);
+    free(h.chave);
+    free(passo);
+    if(!ok){
+        *largura = 0;
+        *preenchimento = 0;
+    }
+    return ok;
 }
 
 //------------------------------------------------------------------------------
-//Separa o grafo em duas partições
+// ordem de eliminação de grau mínimo de g (ver grafo.h)
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
 
-static void bipartido(lista conjA, lista conjB, grafo g){
-    int terminado = 0;
-    vertice auxV = NULL;
-    vertice *vertices = g->vertices;
-    vertice v = vertices[0];        
-    insere_lista(v,conjA);
-    lista filhos = vizinhanca(v,0,g);
+int ordem_grau_minimo(grafo g, unsigned int *ordem, unsigned int *largura, unsigned int *preenchimento){
+    unsigned int l, p;
 
-    for(no auxVizV=primeiro_no(filhos); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        auxV = conteudo(auxVizV);
-        insere_lista(auxV,conjB);   
-        auxV->inSet = 1;     
-    }
+    if(!g || g->direcionado)
+        return 0;
 
-    v->inSet = 1;
-    v->passado = 1;
+    int ok = eliminacao_heuristica(g, 0, ordem, &l, &p);
+    if(largura)
+        *largura = l;
+    if(preenchimento)
+        *preenchimento = p;
+    return ok;
+}
 
-    while(!terminado){
-        terminado = 1;
-        terminado = adicionaConjunto(conjB, conjA, g);
-        terminado = adicionaConjunto(conjA, conjB, g);
-    }
+//------------------------------------------------------------------------------
+// ordem de eliminação de preenchimento mínimo de g (ver grafo.h)
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int ordem_preenchimento_minimo(grafo g, unsigned int *ordem, unsigned int *largura, unsigned int *preenchimento){
+    unsigned int l, p;
+
+    if(!g || g->direcionado)
+        return 0;
+
+    int ok = eliminacao_heuristica(g, 1, ordem, &l, &p);
+    if(largura)
+        *largura = l;
+    if(preenchimento)
+        *preenchimento = p;
+    return ok;
 }
 
 //------------------------------------------------------------------------------
-//Adiciona o id do conjunto em que o vertice esta inserido
+//COMPONENTES
+//------------------------------------------------------------------------------
+// rotula cada vertice de g com o seu componente (ver grafo.h), por buscas em
+// largura sobre as vizinhanças de saída e de entrada, em tempo O(|V|+|E|)
+//
+// devolve o número de componentes ou
+//         0 em caso de erro (ou se g não tem vertices)
+
+unsigned int componentes(grafo g, unsigned int *componente){
+    if(!g || !componente || g->n_vertices == 0)
+        return 0;
+
+    unsigned int n = g->n_vertices;
+    unsigned int *fila = malloc(n * sizeof(unsigned int));
+    if(!fila)
+        return 0;
+
+    for(unsigned int v = 0; v < n; v++)
+        componente[v] = NENHUM;
 
-static void settingConj(lista conj, int id){
-    for(no auxVizVa=primeiro_no(conj); auxVizVa!=NULL; auxVizVa=proximo_no(auxVizVa)){
-        vertice auxVa = conteudo(auxVizVa);
-	    auxVa->set = id;
+    unsigned int total = 0;
+    for(unsigned int r = 0; r < n; r++){
+        if(componente[r] != NENHUM)
+            continue;
+
+        unsigned int ini = 0, fim_fila = 0;
+        componente[r] = total;
+        fila[fim_fila++] = r;
+        while(ini < fim_fila){
+            unsigned int v = fila[ini++];
+            for(unsigned int j = g->inicio_saida[v]; j < g->inicio_saida[v+1]; j++)
+                if(componente[g->alvo_saida[j]] == NENHUM){
+                    componente[g->alvo_saida[j]] = total;
+                    fila[fim_fila++] = g->alvo_saida[j];
+                }
+            for(unsigned int j = g->inicio_entrada[v]; j < g->inicio_entrada[v+1]; j++)
+                if(componente[g->alvo_entrada[j]] == NENHUM){
+                    componente[g->alvo_entrada[j]] = total;
+                    fila[fim_fila++] = g->alvo_entrada[j];
+                }
+        }
+        total++;
     }
+
+    free(fila);
+    return total;
 }
 
 //------------------------------------------------------------------------------
-//Encontra um primeiro emparelhamento no grafo
+// componentes de g agrupados para serem processados um a um: os vertices do
+// componente c, em ordem crescente de id, são
+// membros[inicio[c] .. inicio[c+1]-1], e local[v] é a posição do vertice v
+// dentro do seu componente (seu id no subgrafo do componente)
+//
+// ordem tem os componentes que precisam ser processados (os que têm alguma
+// aresta), do que tem mais arestas para o que tem menos, de forma que os
+// maiores sejam distribuídos entre as threads primeiro
+
+struct fatias {
+    unsigned int n_componentes;
+    unsigned int n_ordem; // número de componentes em ordem
+    unsigned int max_vertices; // maior número de vertices de um componente em ordem
+    unsigned int max_arestas; // maior número de posições de alvo_saida (ou de alvo_entrada) de um componente em ordem
+    unsigned int *inicio;
+    unsigned int *membros;
+    unsigned int *local;
+    unsigned int *ordem;
+};
+
+//------------------------------------------------------------------------------
+// componente e sua chave de ordenação (ver compara_fatias())
+
+struct chave_fatia {
+    unsigned int arestas;
+    unsigned int componente;
+};
 
-static void firstMatching(lista conjA, lista edgeMatching, grafo g){
-    for(no auxVizV=primeiro_no(conjA); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        vertice v = conteudo(auxVizV);
-        lista filhos = vizinhanca(v,0,g);
+//------------------------------------------------------------------------------
+// ordem de qsort() para os componentes: mais arestas primeiro e, entre os de
+// mesmo tamanho, o de menor número
 
-        for(no filhoNo=primeiro_no(filhos); filhoNo!=NULL; filhoNo=proximo_no(filhoNo)){
-            vertice filho = conteudo(filhoNo);
+static int compara_fatias(const void *a, const void *b){
+    const struct chave_fatia *x = a, *y = b;
 
-            if(filho->coberto!=1){
-                filho->coberto = 1;
-                v->coberto = 1;
-                adjacencia viz = malloc(sizeof(struct adjacencia));
-                viz->v_origem = v;
-                viz->v_destino = filho;
-                insere_lista(viz,edgeMatching);
-                break;
-            }
-        }
-    }  
-        
+    if(x->arestas != y->arestas)
+        return x->arestas > y->arestas ? -1 : 1;
+    return x->componente < y->componente ? -1 : x->componente > y->componente;
 }
 
 //------------------------------------------------------------------------------
-//Procura um vertice de origem dentro da lista do primeiro emparelhamento
-//Se encontrar, retorna este vertice
-//Caso contrário, retorna NULL
+// desaloca os vetores de f
 
-static vertice findInMatching(lista edgeMatching, vertice v){
-    for(no edgeNo=primeiro_no(edgeMatching); edgeNo!=NULL; edgeNo=proximo_no(edgeNo)){
-        adjacencia a = conteudo(edgeNo);
-        if(strcmp(a->v_destino->nome, v->nome) == 0)
-            return a->v_origem;
-    }
-    return NULL;
+static void libera_fatias(struct fatias *f){
+    free(f->inicio);
+    free(f->membros);
+    free(f->local);
+    free(f->ordem);
 }
 
 //------------------------------------------------------------------------------
-//reseta para 0 a flag passado, pois ela será reutilizada
+// separa g em componentes (ver struct fatias), em tempo O(|V|+|E|) mais a
+// ordenação dos componentes
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de falta de memória
+
+static int fatia_componentes(grafo g, struct fatias *f){
+    unsigned int n = g->n_vertices;
+    unsigned int *componente = malloc(n * sizeof(unsigned int));
+    struct chave_fatia *chave = NULL;
+
+    f->inicio = f->membros = f->local = f->ordem = NULL;
+    f->n_componentes = componentes(g, componente);
+    f->n_ordem = f->max_vertices = f->max_arestas = 0;
+    if(!componente || f->n_componentes == 0){
+        free(componente);
+        return 0;
+    }
+
+    unsigned int k = f->n_componentes;
+    f->inicio = calloc((size_t) k + 1, sizeof(unsigned int));
+    f->membros = malloc(n * sizeof(unsigned int));
+    f->local = malloc(n * sizeof(unsigned int));
+    f->ordem = malloc(k * sizeof(unsigned int));
+    chave = calloc(k, sizeof(struct chave_fatia));
+    if(!f->inicio || !f->membros || !f->local || !f->ordem || !chave){
+        free(componente);
+        free(chave);
+        libera_fatias(f);
+        return 0;
+    }
+
+    // tamanho de cada componente e posição de cada um em membros
+    for(unsigned int v = 0; v < n; v++){
+        f->inicio[componente[v] + 1]++;
+        chave[componente[v]].arestas += g->inicio_saida[v+1] - g->inicio_saida[v];
+    }
+    for(unsigned int c = 0; c < k; c++){
+        f->inicio[c+1] += f->inicio[c];
+        f->ordem[c] = f->inicio[c]; // próxima posição livre do componente c
+        chave[c].componente = c;
+    }
+
+    // os vertices de cada componente ficam em ordem crescente de id
+    for(unsigned int v = 0; v < n; v++){
+        unsigned int c = componente[v];
+        f->local[v] = f->ordem[c] - f->inicio[c];
+        f->membros[f->ordem[c]++] = v;
+    }
 
-static void resetVisitado(lista conjunto){
-    for(no auxVizV=primeiro_no(conjunto); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        vertice va = conteudo(auxVizV);
-        va->visitado = 0;
+    qsort(chave, k, sizeof(struct chave_fatia), compara_fatias);
+    for(unsigned int i = 0; i < k && chave[i].arestas > 0; i++){
+        unsigned int c = chave[i].componente;
+        f->ordem[f->n_ordem++] = c;
+        if(f->inicio[c+1] - f->inicio[c] > f->max_vertices)
+            f->max_vertices = f->inicio[c+1] - f->inicio[c];
+        if(chave[i].arestas > f->max_arestas)
+            f->max_arestas = chave[i].arestas;
     }
+
+    free(componente);
+    free(chave);
+    return 1;
 }
 
 //------------------------------------------------------------------------------
-//Se houver um caminho de um vertice descoberto, procura um caminho que o ligue
-//até outro vertice do conjunto oposto que também esta descoberto
-//retorna o caminho, se tiver
-//retorna NULL, caso contrário
+// monta em sub o subgrafo de g induzido pelo componente c de f, com os ids
+// locais de f->local; sub usa os vetores inicio (max_vertices+1 posições) e
+// alvo (max_arestas posições) de quem chama, com o dobro disso se g é
+// direcionado: a segunda metade de cada um guarda a vizinhança de entrada
+//
+// só os campos usados pelos algoritmos sobre ids (n_vertices, direcionado e
+// os vetores CSR de saída e de entrada) são preenchidos
 
-static lista findAumentingPath(lista conjA, lista conjB, lista emp, grafo g){
-    int terminou = 1;
-    lista auxPath = constroi_lista();
-    lista path = constroi_lista();
-    vertice va = NULL;
-    vertice vb = NULL;
-    vertice filho = NULL;
-    
-    resetVisitado(conjA);
-    resetVisitado(conjB);
-    
-    for(no auxVizV=primeiro_no(conjA); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        va = conteudo(auxVizV);
-        if(va->coberto!=1 && va->passado !=1){
-            terminou = 0;
-            va->passado = 1;
-            break;
+static void monta_fatia(grafo g, struct fatias *f, unsigned int c, struct grafo *sub,
+                        unsigned int *inicio, unsigned int *alvo){
+    unsigned int k = f->inicio[c+1] - f->inicio[c];
+    unsigned int *membros = f->membros + f->inicio[c];
+
+    memset(sub, 0, sizeof(struct grafo));
+    sub->direcionado = g->direcionado;
+    sub->n_vertices = k;
+    sub->inicio_saida = sub->inicio_entrada = inicio;
+    sub->alvo_saida = sub->alvo_entrada = alvo;
+    if(g->direcionado){
+        sub->inicio_entrada = inicio + f->max_vertices + 1;
+        sub->alvo_entrada = alvo + f->max_arestas;
+    }
+
+    // num grafo não direcionado a vizinhança de entrada é a de saída
+    for(int sentido = 0; sentido < (g->direcionado ? 2 : 1); sentido++){
+        unsigned int *inicio_g = sentido ? g->inicio_entrada : g->inicio_saida;
+        unsigned int *alvo_g = sentido ? g->alvo_entrada : g->alvo_saida;
+        unsigned int *inicio_sub = sentido ? sub->inicio_entrada : sub->inicio_saida;
+        unsigned int *alvo_sub = sentido ? sub->alvo_entrada : sub->alvo_saida;
+        unsigned int m = 0;
+
+        for(unsigned int i = 0; i < k; i++){
+            unsigned int v = membros[i];
+            inicio_sub[i] = m;
+            for(unsigned int j = inicio_g[v]; j < inicio_g[v+1]; j++)
+                alvo_sub[m++] = f->local[alvo_g[j]];
         }
+        inicio_sub[k] = m;
     }
-    
-    for(no auxV=primeiro_no(conjB); auxV!=NULL; auxV=proximo_no(auxV)){
-        vb = conteudo(auxV);
-        if(vb->coberto!=1){
-            terminou = 0;
+}
+
+//------------------------------------------------------------------------------
+// função aplicada a cada componente por processa_fatias(): recebe o
+// subgrafo do componente, seus membros (ids em g, na ordem dos ids locais) e
+// o contexto de quem chamou, e soma seu resultado em *valor
+//
+// devolve 1 para continuar ou
+//         0 para interromper o processamento (resultado já decidido ou erro)
+
+typedef int (*tarefa_fatia)(grafo sub, const unsigned int *membros, void *contexto, unsigned int *valor);
+
+//------------------------------------------------------------------------------
+// estado compartilhado pelas threads de processa_fatias()
+
+struct trabalho_fatias {
+    grafo g;
+    struct fatias *f;
+    tarefa_fatia tarefa;
+    void *contexto;
+    unsigned int proximo; // próxima posição de f->ordem a processar
+    unsigned int soma; // soma dos valores devolvidos pelas tarefas
+    int interrompido; // 1 se alguma tarefa pediu para parar
+    int padding; // só pra evitar warning
+    pthread_mutex_t trava;
+};
+
+//------------------------------------------------------------------------------
+// thread de processa_fatias(): pega o próximo componente de f->ordem, monta
+// seu subgrafo em vetores próprios e aplica a tarefa, até acabarem os
+// componentes ou o processamento ser interrompido
+
+static void *trabalha_fatias(void *arg){
+    struct trabalho_fatias *t = arg;
+    size_t partes = t->g->direcionado ? 2 : 1; // saída e, se direcionado, entrada
+    unsigned int *inicio = malloc(partes * ((size_t) t->f->max_vertices + 1) * sizeof(unsigned int));
+    unsigned int *alvo = malloc(partes * (t->f->max_arestas ? t->f->max_arestas : 1) * sizeof(unsigned int));
+    int ok = inicio && alvo;
+
+    while(ok){
+        pthread_mutex_lock(&t->trava);
+        if(t->interrompido || t->proximo == t->f->n_ordem){
+            pthread_mutex_unlock(&t->trava);
             break;
         }
+        unsigned int c = t->f->ordem[t->proximo++];
+        pthread_mutex_unlock(&t->trava);
+
+        struct grafo sub;
+        unsigned int valor = 0;
+        monta_fatia(t->g, t->f, c, &sub, inicio, alvo);
+        ok = t->tarefa(&sub, t->f->membros + t->f->inicio[c], t->contexto, &valor);
+
+        pthread_mutex_lock(&t->trava);
+        t->soma += valor;
+        pthread_mutex_unlock(&t->trava);
     }
-        
-    while(terminou!=1 && vb != NULL){
-        terminou = 1;
-        filho = NULL;
-        //caso: vertice coberto para vertice coberto
-        if(va->coberto == 1){
-            filho = findInMatching(emp, va);
-            if(filho != NULL && filho->visitado!=1){
-	            terminou = 0;
-                filho->visitado = 1;
-                insere_lista(va,auxPath);
-                adjacencia viz = malloc(sizeof(struct adjacencia));                       
-                viz->v_origem = va;
-                viz->v_destino = filho;
-                insere_lista(viz,path);
-                va = filho;
-            }
-        }
-        //caso: vertice inicial não coberto
-        if(filho == NULL || va->coberto == 0){
-            lista filhos = vizinhanca(va,0,g);
-            va->visitado = 1;
-            for(no filhoNo=primeiro_no(filhos); filhoNo!=NULL; filhoNo=proximo_no(filhoNo)){
-                filho = conteudo(filhoNo);
-                if(filho->coberto==1 && filho->visitado!=1){
-                    terminou = 0;
-                    filho->visitado = 1;
-                    insere_lista(va,auxPath);
-                    adjacencia viz = malloc(sizeof(struct adjacencia));                       
-                    viz->v_origem = va;
-                    viz->v_destino = filho;
-                    insere_lista(viz,path);
-                    va = filho;
-                    break;
-                }
-                else if (filho->coberto == 0 && filho->set != 0){
-                    adjacencia viz = malloc(sizeof(struct adjacencia));                       
-                    viz->v_origem = va;
-                    viz->v_destino = filho;
-                    insere_lista(viz,path);
-                    return path;
-                }
-            }
-        }
-        //caso: não achou o caminho certo, ou procura um proximo, mas se chegou ao final da lista retorna
-        if(terminou){
-            if (primeiro_no(auxPath) == NULL){
-                terminou = 1;
-            }
-            else {
-                va = conteudo(primeiro_no(auxPath));
-                remove_no(auxPath, primeiro_no(auxPath), NULL);
-                remove_no(path, primeiro_no(path), NULL);
-                terminou = 0;
-            }
-		}
+
+    if(!ok){
+        pthread_mutex_lock(&t->trava);
+        t->interrompido = 1;
+        pthread_mutex_unlock(&t->trava);
     }
+    free(inicio);
+    free(alvo);
     return NULL;
 }
 
 //------------------------------------------------------------------------------
-//Executar o xor entre a lista que contem o caminho aumentante e o primeiro 
-//emparelhamento encontrado
+// aplica tarefa a cada componente de g que tem arestas, com até n_threads
+// threads (a que chama é uma delas), somando em *soma os valores devolvidos
+//
+// devolve 1, se todas as tarefas foram feitas ou
+//         0, se alguma interrompeu o processamento (ou faltou memória)
 
-static void changeMatching(lista emp, lista path){
-    for(no pathNo=primeiro_no(path); pathNo!=NULL; pathNo=proximo_no(pathNo)){
-        adjacencia a_path= conteudo(pathNo);
-        
-        for(no empNo=primeiro_no(emp); empNo!=NULL; empNo=proximo_no(empNo)){
-        	adjacencia a_emp= conteudo(empNo);
-		
-            if(strcmp(a_path->v_origem->nome, a_emp->v_origem->nome) == 0){
-			    a_emp->v_destino->coberto = 0;
-			    a_emp->v_destino = a_path->v_destino;
-			    a_emp->v_destino->coberto = 1;
-		    }
-		
-            else if((a_path->v_origem->coberto == 0) && (a_path->v_destino->coberto == 0)){
-			    a_path->v_origem->coberto = 1;
-			    a_path->v_destino->coberto = 1;
-			    insere_lista(a_path, emp);
-		    }
-	    }
-    }
+static int processa_fatias(grafo g, unsigned int n_threads, tarefa_fatia tarefa, void *contexto, unsigned int *soma){
+    struct fatias f;
+    struct trabalho_fatias t;
+
+    *soma = 0;
+    if(g->n_vertices == 0)
+        return 1;
+    if(!fatia_componentes(g, &f))
+        return 0;
+
+    t.g = g;
+    t.f = &f;
+    t.tarefa = tarefa;
+    t.contexto = contexto;
+    t.proximo = 0;
+    t.soma = 0;
+    t.interrompido = 0;
+    pthread_mutex_init(&t.trava, NULL);
+
+    if(n_threads > f.n_ordem)
+        n_threads = f.n_ordem;
+    pthread_t *threads = n_threads > 1 ? malloc((n_threads - 1) * sizeof(pthread_t)) : NULL;
+    unsigned int criadas = 0;
+    if(threads)
+        for(; criadas < n_threads - 1; criadas++)
+            if(pthread_create(threads + criadas, NULL, trabalha_fatias, &t) != 0)
+                break;
+
+    trabalha_fatias(&t);
+    for(unsigned int i = 0; i < criadas; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+    pthread_mutex_destroy(&t.trava);
+    libera_fatias(&f);
+    *soma = t.soma;
+    return !t.interrompido;
 }
 
 //------------------------------------------------------------------------------
-//reseta para 0 a flag passado, pois ela será reutilizada
+// tarefa de cordal_paralelo(): o componente sub é cordal?
 
-static void resetFlag(lista conjunto){
-    for(no auxVizV=primeiro_no(conjunto); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        vertice va = conteudo(auxVizV);
-        va->passado = 0;
-    }
+static int cordal_fatia(grafo sub, const unsigned int *membros, void *contexto, unsigned int *valor){
+    (void) membros;
+    (void) contexto;
+    (void) valor;
+    return cordal(sub);
+}
+
+//------------------------------------------------------------------------------
+// devolve 1, se g é um grafo cordal ou
+//         0, caso contrário
+//
+// cada componente de g é verificado à parte, por até n_threads threads; num
+// grafo direcionado a busca de cordal() só segue os arcos de saída e o
+// resultado depende da ordem da busca no grafo inteiro, então g é
+// verificado por cordal(), sem fatias
 
+int cordal_paralelo(grafo g, unsigned int n_threads){
+    unsigned int soma;
+
+    if(!g)
+        return 0;
+    if(g->direcionado)
+        return cordal(g);
+    return processa_fatias(g, n_threads, cordal_fatia, NULL, &soma);
 }
+
 //------------------------------------------------------------------------------
-//Faz uma busca para verificar se todos os vertices da partição estão cobertos
-//retorna 1, se estiverem
-//retorna 0, caso contrario.
+// tarefa de emparelhamento_maximo_id_paralelo(): emparelhamento máximo do
+// componente sub, copiado para par (o contexto), com os ids de g; o tamanho
+// vai para *valor
 
-static int allCovered(lista conjunto){
-    for(no auxVizV=primeiro_no(conjunto); auxVizV!=NULL; auxVizV=proximo_no(auxVizV)){
-        vertice v = conteudo(auxVizV);
-        if(v->coberto == 0){
-            return 0;
-        }
+static int emparelhamento_fatia(grafo sub, const unsigned int *membros, void *contexto, unsigned int *valor){
+    unsigned int *par = contexto;
+    unsigned int *par_local = malloc(sub->n_vertices * sizeof(unsigned int));
+
+    if(!par_local || !emparelhamento_maximo_id(sub, par_local, valor)){
+        free(par_local);
+        return 0;
     }
+    for(unsigned int i = 0; i < sub->n_vertices; i++)
+        par[membros[i]] = par_local[i] == NENHUM ? NENHUM : membros[par_local[i]];
+
+    free(par_local);
     return 1;
 }
 
 //------------------------------------------------------------------------------
-// devolve um grafo cujos vertices são cópias de vértices do grafo
-// bipartido g e cujas arestas formam um emparelhamento máximo em g
+// igual a emparelhamento_maximo_id(), mas com cada componente de g
+// emparelhado à parte, por até n_threads threads
 //
-// não verifica se g é bipartido; caso não seja, o comportamento é indefinido
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
 
-grafo emparelhamento_maximo(grafo g){
-    grafo e = cria_grafo(g->nome, g->direcionado, g->ponderado, (int) g->n_vertices);
-    lista conjA = constroi_lista();
-    lista conjB = constroi_lista();
-    lista path;
-    lista edgeMatching = constroi_lista();
-    int allA = 0;
-    int allB = 0;
-    int aumentingPath = 1;
-
-    bipartido(conjA,conjB,g);
-   
-    settingConj(conjA, 0);
-    settingConj(conjB, 1);
+int emparelhamento_maximo_id_paralelo(grafo g, unsigned int *par, unsigned int *tamanho, unsigned int n_threads){
+    if(!g || !par || !tamanho)
+        return 0;
 
-    firstMatching(conjA, edgeMatching, g);
+    // vertices de componentes sem arestas ficam livres
+    for(unsigned int v = 0; v < g->n_vertices; v++)
+        par[v] = NENHUM;
 
-    resetFlag(conjA);
-    resetFlag(conjB);
+    int ok = processa_fatias(g, n_threads, emparelhamento_fatia, par, tamanho);
+    if(!ok)
+        *tamanho = 0;
+    return ok;
+}
 
-    while(aumentingPath){
-        allA = allCovered(conjA);
-        allB = allCovered(conjB);
+//------------------------------------------------------------------------------
+// igual a emparelhamento_maximo(), mas com cada componente de g emparelhado
+// à parte, por até n_threads threads
 
-        if(allA == 1 || allB == 1){
-            aumentingPath = 0;
-            break;
-        }
-        
-    	path = findAumentingPath(conjA,conjB, edgeMatching, g);
-    	if(path != NULL){
-    		changeMatching(edgeMatching, path);
-	    }
-	    else{
-		    aumentingPath = 0;
-	    }
-    }
-    for(no edgeNo=primeiro_no(edgeMatching); edgeNo!=NULL; edgeNo=proximo_no(edgeNo)){
-	    adjacencia a = conteudo(edgeNo);
-	    vertice origem = cria_vertice(e, a->v_origem->nome);
-	    vertice destino = cria_vertice(e, a->v_destino->nome);
-	    cria_vizinhanca(e, origem, destino, a->peso);
-    }
-	    
+grafo emparelhamento_maximo_paralelo(grafo g, unsigned int n_threads){
+    if(!g)
+        return NULL;
+
+    unsigned int *par = malloc((g->n_vertices ? g->n_vertices : 1) * sizeof(unsigned int));
+    unsigned int tamanho;
+    if(!par || !emparelhamento_maximo_id_paralelo(g, par, &tamanho, n_threads)){
+        free(par);
+        return NULL;
+    }
+
+    grafo e = monta_emparelhamento(g, par, tamanho);
+    free(par);
     return e;
 }
@@ -125,7 +125,32 @@ typedef struct vertice *vertice;
 char *nome_vertice(vertice v);
 
 //------------------------------------------------------------------------------
-// lê um grafo no formato dot de input, usando as rotinas de libcgraph
+// devolve o id do vertice v: sua posição no grafo, de 0 a n_vertices(g)-1,
+// usada como índice nos vetores das funções que trabalham com ids; devolve
+// UINT_MAX se v é NULL
+
+unsigned int id_vertice(vertice v);
+
+//------------------------------------------------------------------------------
+// devolve o vertice de id id em g, ou NULL se não existe
+
+vertice vertice_id(unsigned int id, grafo g);
+
+//------------------------------------------------------------------------------
+// devolve o vertice de nome nome no grafo g, ou
+//         NULL, se g não tem vertice com esse nome
+//
+// a busca usa um índice hash mantido pelo grafo e tem tempo esperado O(1)
+
+vertice busca_vertice(const char *nome, grafo g);
+
+//------------------------------------------------------------------------------
+// lê um grafo no formato dot de input
+//
+// o subconjunto do formato dot usado nos arquivos de exemplo (graph/digraph,
+// strict, declarações de vértices e de arestas/arcos, listas de atributos,
+// comentários) é lido diretamente, em uma única passada; para qualquer outra
+// construção a leitura é feita com as rotinas de libcgraph
 // 
 // desconsidera todos os atributos do grafo lido exceto o atributo
 // "peso" quando ocorrer; neste caso o valor do atributo é o peso da
@@ -137,12 +162,30 @@ char *nome_vertice(vertice v);
 // 
 // todas as estruturas de dados alocadas pela libcgraph são
 // desalocadas ao final da execução
+//
+// pode ser chamada por várias threads ao mesmo tempo; as leituras que
+// recorrem à libcgraph (que não é reentrante) são feitas uma de cada vez
 // 
 // devolve o grafo lido ou
 //         NULL em caso de erro 
 
 grafo le_grafo(FILE *input);  
 
+//------------------------------------------------------------------------------
+// congela o grafo g: converte suas listas de adjacência em vetores
+// contíguos (formato CSR, indexados pelo id de cada vértice) e desaloca
+// as listas
+//
+// todas as funções de consulta e os algoritmos deste módulo percorrem a
+// representação CSR; le_grafo(), copia_grafo() e emparelhamento_maximo()
+// já devolvem grafos congelados, de forma que chamar congela_grafo() sobre
+// eles não faz nada
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int congela_grafo(grafo g);
+
 //------------------------------------------------------------------------------
 // desaloca toda a memória usada em *g
 // 
@@ -162,16 +205,75 @@ int destroi_grafo(void *g);
 // 2. se uma aresta tem peso, este deve ser escrito como um atributo 
 //    de nome "peso"
 //
+// o grafo é escrito como estrito (strict graph ou strict digraph): cada
+// aresta aparece uma única vez e arestas/arcos repetidos são escritos com o
+// peso do primeiro; os vértices saem em ordem de id e os nomes só são postos
+// entre aspas quando necessário
+//
+// não usa a libcgraph e pode ser chamada por várias threads ao mesmo tempo
+//
 // devolve o grafo escrito ou
 //         NULL em caso de erro 
 
 grafo escreve_grafo(FILE *output, grafo g);
 
 //------------------------------------------------------------------------------
-// devolve um grafo igual a g
+// escreve o grafo g em output num formato binário versionado, com soma de
+// verificação, que pode ser mapeado em memória por carrega_grafo_binario()
+//
+// o arquivo só pode ser lido numa máquina com a mesma ordem de bytes e o
+// mesmo tamanho de long int
+//
+// devolve 1 em caso de sucesso ou
+//         0 em caso de erro
+
+int salva_grafo_binario(FILE *output, grafo g);
+
+//------------------------------------------------------------------------------
+// lê um grafo gravado por salva_grafo_binario() mapeando input em memória
+//
+// os nomes e as adjacências são usados diretamente da imagem mapeada, sem
+// análise e sem alocação por elemento; a memória é liberada por
+// destroi_grafo()
+//
+// além da soma de verificação, os vetores de ids (vizinhanças, índice de
+// nomes) são conferidos uma vez na leitura, em tempo O(|V(G)|+|E(G)|), de
+// forma que nem um arquivo montado de propósito leva a acessos fora deles
+//
+// devolve o grafo lido ou
+//         NULL em caso de erro (arquivo de outra versão ou arquitetura,
+//              truncado ou corrompido)
+
+grafo carrega_grafo_binario(FILE *input);
+
+//------------------------------------------------------------------------------
+// devolve um grafo igual a g, independente de g (g pode ser destruído antes
+// da cópia), ou
+//         NULL em caso de falta de memória
+//
+// a cópia é feita em poucas alocações, sem percorrer as adjacências
+// elemento a elemento; o custo é proporcional ao tamanho de g em memória
 
 grafo copia_grafo(grafo g);
 
+//------------------------------------------------------------------------------
+// constrói e devolve um grafo de nome nome, direcionado se direcionado == 1,
+// com n vértices de nomes "0", "1", ..., "n-1" (o vértice de id i tem nome
+// "i") e com as m arestas/arcos de origem[k] para destino[k], k < m
+//
+// se peso != NULL o grafo é ponderado e peso[k] é o peso da aresta/arco k;
+// as arestas não são verificadas quanto a repetições
+//
+// com as arestas ordenadas pela origem, o grafo é igual ao que le_grafo()
+// devolve para o arquivo dot com os vértices declarados em ordem e depois
+// as arestas/arcos
+//
+// devolve o grafo construído ou
+//         NULL em caso de erro (ids fora de [0, n) ou falta de memória)
+
+grafo constroi_grafo(const char *nome, int direcionado, unsigned int n, unsigned int m,
+                     const unsigned int *origem, const unsigned int *destino, const long int *peso);
+
 //------------------------------------------------------------------------------
 // devolve a vizinhança do vértice v no grafo g
 // 
@@ -186,6 +288,47 @@ grafo copia_grafo(grafo g);
 
 lista vizinhanca(vertice v, int direcao, grafo g);
 
+//------------------------------------------------------------------------------
+// cursor para percorrer a vizinhança de um vértice sem alocar memória
+//
+// uso:
+//
+//     cursor_vizinhos c;
+//     long int peso;
+//
+//     inicia_vizinhos(&c, v, direcao, g);
+//     for (vertice w = proximo_vizinho(&c, &peso); w; w = proximo_vizinho(&c, &peso))
+//         ...
+//
+// os campos são de uso interno; o cursor deixa de ser válido se g for
+// destruído
+
+typedef struct cursor_vizinhos {
+    vertice *vertices;
+    unsigned int *alvo;
+    long int *peso;
+    unsigned int atual;
+    unsigned int fim;
+} cursor_vizinhos;
+
+//------------------------------------------------------------------------------
+// posiciona o cursor c no início da vizinhança do vértice v no grafo g
+//
+// direcao tem o mesmo significado que em vizinhanca(); se direcao for
+// inválida ou g == NULL a vizinhança percorrida é vazia
+
+void inicia_vizinhos(cursor_vizinhos *c, vertice v, int direcao, grafo g);
+
+//------------------------------------------------------------------------------
+// devolve o próximo vizinho do cursor c, ou
+//         NULL, se a vizinhança já foi toda percorrida
+//
+// se peso != NULL, *peso recebe o peso da aresta/arco até o vizinho
+//
+// os vizinhos aparecem na mesma ordem que em vizinhanca()
+
+vertice proximo_vizinho(cursor_vizinhos *c, long int *peso);
+
 //------------------------------------------------------------------------------
 // devolve o grau do vértice v no grafo g
 // 
@@ -206,6 +349,8 @@ unsigned int grau(vertice v, int direcao, grafo g);
 //
 // um conjunto C de vértices de um grafo é uma clique em g 
 // se todo vértice em C é vizinho de todos os outros vértices de C em g
+//
+// usa a área de trabalho da thread que chama (ver cria_area_trabalho())
 
 int clique(lista l, grafo g);
 
@@ -214,15 +359,109 @@ int clique(lista l, grafo g);
 //         0, caso contrário
 //
 // um vértice é simplicial no grafo se sua vizinhança é uma clique
+//
+// usa a área de trabalho da thread que chama (ver cria_area_trabalho())
 
 int simplicial(vertice v, grafo g);
 
+//------------------------------------------------------------------------------
+// (apontador para) área de trabalho: vetores auxiliares, indexados pelo id
+// dos vértices, usados por clique() e simplicial()
+//
+// as consultas e os algoritmos deste módulo não alteram o grafo (a não ser
+// pela construção da matriz de bits, ver constroi_bitset(), que é segura
+// entre threads), de forma que um mesmo grafo pode ser consultado por várias
+// threads ao mesmo tempo; os algoritmos alocam seus vetores a cada chamada,
+// e clique() e simplicial() usam uma área de trabalho própria de cada
+// thread, reaproveitada de uma chamada (e de um grafo) para outra
+
+typedef struct area_trabalho *area_trabalho;
+
+//------------------------------------------------------------------------------
+// cria uma área de trabalho vazia; os vetores são alocados sob demanda, do
+// tamanho do maior grafo em que a área é usada
+//
+// devolve a área criada ou
+//         NULL em caso de falta de memória
+
+area_trabalho cria_area_trabalho(void);
+
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada em a
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int destroi_area_trabalho(area_trabalho a);
+
+//------------------------------------------------------------------------------
+// iguais a clique() e simplicial(), mas usando a área de trabalho a, que
+// não pode ser usada por duas chamadas ao mesmo tempo
+
+int clique_area(lista l, grafo g, area_trabalho a);
+
+int simplicial_area(vertice v, grafo g, area_trabalho a);
+
+//------------------------------------------------------------------------------
+// constrói a matriz de adjacência em bits de g (n_vertices(g)^2/8 bytes),
+// usada por clique() e simplicial(): com ela, verificar se um vértice é
+// vizinho de todos os outros de um conjunto custa um AND e uma contagem de
+// bits por palavra de 64 bits (com AVX2, quando o processador tem)
+//
+// clique() e simplicial() constroem a matriz automaticamente, na primeira
+// chamada, em grafos com até LIMITE_BITSET vértices (8192, configurável na
+// compilação de grafo.c); esta função permite construí-la para grafos
+// maiores
+//
+// pode ser chamada por várias threads ao mesmo tempo: a matriz só é
+// publicada depois de completa, e apenas uma delas fica no grafo
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int constroi_bitset(grafo g);
+
 //------------------------------------------------------------------------------
 // devolve uma lista de vertices com a ordem dos vértices dada por uma 
 // busca em largura lexicográfica
+//
+// o último vértice visitado é o primeiro da lista
 
 lista busca_largura_lexicografica(grafo g);
 
+//------------------------------------------------------------------------------
+// preenche ordem[0..n-1] (n = n_vertices(g)) com os ids dos vértices de g na
+// ordem em que são visitados por uma busca em largura lexicográfica e
+// posicao[id] com a posição em ordem do vértice de id id
+//
+// a busca é feita por refinamento de partição e cobre todos os componentes
+// do grafo, em tempo O(|V(G)|+|E(G)|)
+//
+// o id de um vértice é sua posição na ordem de criação (leitura) do grafo
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int ordem_lexicografica(grafo g, unsigned int *ordem, unsigned int *posicao);
+
+//------------------------------------------------------------------------------
+// devolve uma lista de vertices com a ordem dos vértices dada por uma
+// busca por cardinalidade máxima (em que o próximo vértice visitado é
+// sempre um dos que têm mais vizinhos já visitados)
+//
+// o último vértice visitado é o primeiro da lista; como no caso da busca em
+// largura lexicográfica, a lista é uma ordem perfeita de eliminação se e
+// somente se g é cordal
+
+lista busca_cardinalidade_maxima(grafo g);
+
+//------------------------------------------------------------------------------
+// igual a ordem_lexicografica(), mas com a ordem de visita de uma busca por
+// cardinalidade máxima, feita com uma fila de prioridade por baldes em tempo
+// O(|V(G)|+|E(G)|)
+
+int ordem_cardinalidade(grafo g, unsigned int *ordem, unsigned int *posicao);
+
 //------------------------------------------------------------------------------
 // devolve 1, se a lista l representa uma 
 //            ordem perfeita de eliminação para o grafo g ou
@@ -232,18 +471,404 @@ lista busca_largura_lexicografica(grafo g);
 
 int ordem_perfeita_eliminacao(lista l, grafo g);
 
+//------------------------------------------------------------------------------
+// devolve 1, se ordem[0..n-1] (n = n_vertices(g)), com os ids dos vértices
+//            de g na ordem em que são eliminados, é uma
+//            ordem perfeita de eliminação para o grafo g ou
+//         0, caso contrário (inclusive se ordem não contém cada id uma vez)
+//
+// o tempo de execução é O(|V(G)|+|E(G)|)
+
+int ordem_perfeita_eliminacao_id(grafo g, unsigned int *ordem);
+
 //------------------------------------------------------------------------------
 // devolve 1, se g é um grafo cordal ou
 //         0, caso contrário
 
 int cordal(grafo g);
 
+//------------------------------------------------------------------------------
+// buscas que geram uma ordem candidata a ordem perfeita de eliminação (o
+// reverso da ordem de visita): a busca em largura lexicográfica e a busca
+// por cardinalidade máxima
+
+enum busca_eliminacao {
+    BUSCA_LEXICOGRAFICA,
+    BUSCA_CARDINALIDADE
+};
+
+//------------------------------------------------------------------------------
+// igual a cordal(), com a ordem candidata dada pela busca busca; cordal(g)
+// é cordal_busca(g, BUSCA_LEXICOGRAFICA)
+
+int cordal_busca(grafo g, enum busca_eliminacao busca);
+
+//------------------------------------------------------------------------------
+// devolve 1, se g é um grafo cordal, como cordal(),
+//         0, caso contrário, ou
+//        -1, se g é direcionado (a verificação de cordal() num grafo
+//            direcionado não dá um ciclo sem cordas como certificado; use
+//            cordal())
+//
+// se g não é cordal e ciclo não é NULL (n = n_vertices(g) posições,
+// alocadas por quem chama), ciclo recebe os ids dos vértices de um ciclo sem
+// cordas de g com pelo menos 4 vértices, na ordem do ciclo, e
+// *tamanho_ciclo, se tamanho_ciclo não é NULL, o seu tamanho; em caso de
+// falta de memória a função devolve 0 com *tamanho_ciclo == 0
+//
+// o ciclo é extraído da falha da ordem perfeita de eliminação candidata (o
+// reverso da busca em largura lexicográfica), e o tempo de execução é
+// O(|V(G)|+|E(G)|)
+
+int cordal_ciclo(grafo g, unsigned int *ciclo, unsigned int *tamanho_ciclo);
+
+//------------------------------------------------------------------------------
+// calcula uma clique máxima do grafo cordal g a partir de uma ordem perfeita
+// de eliminação, em tempo O(|V(G)|+|E(G)|)
+//
+// ordem[0..n-1] (n = n_vertices(g)) tem os ids dos vértices na ordem em que
+// são eliminados, como em ordem_perfeita_eliminacao_id(); se ordem é NULL,
+// é usado o reverso da busca em largura lexicográfica, como em cordal()
+//
+// se clique não é NULL (n posições, alocadas por quem chama), recebe os ids
+// dos vértices da clique
+//
+// devolve o tamanho da clique máxima (o número de clique de g) ou
+//         0 se ordem não é uma ordem perfeita de eliminação (g não é cordal,
+//           se ordem é NULL), se g não tem vértices ou em caso de erro
+
+unsigned int clique_maxima_id(grafo g, const unsigned int *ordem, unsigned int *clique);
+
+//------------------------------------------------------------------------------
+// devolve uma lista com os vértices de uma clique máxima do grafo cordal g,
+// calculada como em clique_maxima_id() a partir da ordem perfeita de
+// eliminação l (por exemplo, a lista de busca_largura_lexicografica()) ou,
+// se l é NULL, do reverso da busca em largura lexicográfica, ou
+//         NULL se l não é uma ordem perfeita de eliminação para g (ou em
+//           caso de erro)
+
+lista clique_maxima(lista l, grafo g);
+
+//------------------------------------------------------------------------------
+// calcula uma coloração ótima dos vértices do grafo cordal g a partir de uma
+// ordem perfeita de eliminação (ordem, como em clique_maxima_id()), em tempo
+// O(|V(G)|+|E(G)|)
+//
+// cor[id] (n = n_vertices(g) posições, alocadas por quem chama) recebe a cor
+// do vértice de id id, de 0 ao número de cores menos 1; vértices vizinhos
+// têm cores diferentes
+//
+// num grafo cordal o número cromático é igual ao número de clique, e a
+// coloração usa exatamente esse número de cores
+//
+// devolve o número de cores usadas ou
+//         0 se ordem não é uma ordem perfeita de eliminação (g não é cordal,
+//           se ordem é NULL), se g não tem vértices ou em caso de erro
+
+unsigned int coloracao_otima_id(grafo g, const unsigned int *ordem, unsigned int *cor);
+
+//------------------------------------------------------------------------------
+// (apontador para) árvore de cliques de um grafo cordal: as cliques maximais
+// do grafo, numeradas de 0 a n_cliques-1, ligadas numa floresta (uma árvore
+// por componente) em que as cliques que contêm cada vértice formam uma
+// subárvore
+//
+// a clique c tem os vértices membros[inicio[c] .. inicio[c+1]-1], dos quais
+// os tamanho_separador[c] primeiros formam o separador entre c e a sua
+// clique pai, pai[c] (pai[c] < c, ou UINT_MAX se c é uma raiz, com
+// separador vazio)
+//
+// as cliques que contêm o vértice de id v são
+// cliques[inicio_vertice[v] .. inicio_vertice[v+1]-1], em ordem crescente
+//
+// os separadores das arestas da árvore são os separadores minimais de
+// vértices do grafo (um separador pode aparecer em mais de uma aresta)
+
+typedef struct arvore_cliques {
+    unsigned int n_vertices;
+    unsigned int n_cliques;
+    unsigned int *inicio;               // n_cliques+1 posições
+    unsigned int *membros;
+    unsigned int *tamanho_separador;    // n_cliques posições
+    unsigned int *pai;                  // n_cliques posições
+    unsigned int *inicio_vertice;       // n_vertices+1 posições
+    unsigned int *cliques;
+} *arvore_cliques;
+
+//------------------------------------------------------------------------------
+// constrói a árvore de cliques do grafo cordal g a partir de uma ordem
+// perfeita de eliminação (ordem, como em clique_maxima_id(); NULL para o
+// reverso da busca em largura lexicográfica), em tempo O(|V(G)|+|E(G)|)
+//
+// devolve a árvore construída ou
+//         NULL se ordem não é uma ordem perfeita de eliminação (g não é
+//           cordal, se ordem é NULL) ou em caso de erro
+
+arvore_cliques constroi_arvore_cliques(grafo g, const unsigned int *ordem);
+
+//------------------------------------------------------------------------------
+// devolve o número de cliques de a que contêm o vértice de id v e, se
+// cliques não é NULL, aponta *cliques para os números delas (em ordem
+// crescente, dentro de a), ou
+//         0 se v não é um id válido
+
+unsigned int cliques_com_vertice(arvore_cliques a, unsigned int v, const unsigned int **cliques);
+
+//------------------------------------------------------------------------------
+// devolve o tamanho do separador entre a clique c de a e a sua clique pai
+// (0 se c é uma raiz) e, se separador não é NULL, aponta *separador para os
+// ids dos seus vértices (dentro de a), ou
+//         0 se c não é uma clique de a
+
+unsigned int separador_clique(arvore_cliques a, unsigned int c, const unsigned int **separador);
+
+//------------------------------------------------------------------------------
+// desaloca toda a memória usada por a
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int destroi_arvore_cliques(arvore_cliques a);
+
+//------------------------------------------------------------------------------
+// calcula uma triangulação mínima do grafo não direcionado g: um conjunto de
+// arestas de preenchimento que, acrescentadas a g, o tornam cordal, e do
+// qual nenhuma aresta pode ser retirada sem que o grafo deixe de ser cordal
+//
+// usa o algoritmo MCS-M, uma busca por cardinalidade máxima que também
+// conta os vértices alcançados por caminhos de vértices de peso menor, em
+// tempo O(|V(G)|.|E(G)|); se g já é cordal, não acrescenta arestas
+//
+// se ordem não é NULL (n = n_vertices(g) posições, alocadas por quem chama),
+// recebe os ids dos vértices numa ordem perfeita de eliminação do grafo
+// triangulado, como em ordem_perfeita_eliminacao_id()
+//
+// *tamanho recebe o número de arestas de preenchimento e, se preenchimento
+// não é NULL, *preenchimento recebe um vetor (alocado com malloc(), a ser
+// liberado por quem chama) com as suas 2*(*tamanho) extremidades: a aresta
+// k é {(*preenchimento)[2k], (*preenchimento)[2k+1]}
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário (inclusive se g é direcionado)
+
+int triangulacao_minima(grafo g, unsigned int *ordem, unsigned int **preenchimento, unsigned int *tamanho);
+
+//------------------------------------------------------------------------------
+// devolve um grafo cordal, de mesmo nome, com os vértices (e ids) e arestas
+// do grafo não direcionado g mais as arestas de preenchimento de
+// triangulacao_minima(), com peso 0, ou
+//         NULL em caso de erro (inclusive se g é direcionado)
+
+grafo triangula_grafo(grafo g);
+
+//------------------------------------------------------------------------------
+// calcula uma ordem de eliminação de grau mínimo do grafo não direcionado g:
+// a cada passo é eliminado o vértice de menor grau (em caso de empate, o
+// primeiro da fila de baldes), e os seus vizinhos ainda não eliminados são
+// ligados entre si pelas arestas de preenchimento
+//
+// se ordem não é NULL (n = n_vertices(g) posições, alocadas por quem chama),
+// recebe os ids dos vértices na ordem em que foram eliminados, uma ordem
+// perfeita de eliminação de g mais as arestas de preenchimento
+//
+// se largura não é NULL, *largura recebe o maior número de vizinhos de um
+// vértice no momento da sua eliminação, um limite superior para a largura de
+// árvore de g; se preenchimento não é NULL, *preenchimento recebe o número
+// de arestas de preenchimento
+//
+// a eliminação de um vértice custa O(soma dos graus dos seus vizinhos no
+// grafo de eliminação)
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário (inclusive se g é direcionado)
+
+int ordem_grau_minimo(grafo g, unsigned int *ordem, unsigned int *largura, unsigned int *preenchimento);
+
+//------------------------------------------------------------------------------
+// como ordem_grau_minimo(), mas a cada passo é eliminado o vértice cuja
+// eliminação acrescenta menos arestas de preenchimento (em caso de empate, o
+// de menor id)
+//
+// em geral dá menos preenchimento e largura menor ou igual à de
+// ordem_grau_minimo(), a um custo maior: depois de cada eliminação que
+// acrescenta arestas, é recalculado o preenchimento dos vizinhos do vértice
+// eliminado e dos vizinhos deles
+//
+// num grafo cordal há sempre um vértice simplicial, sem preenchimento, e a
+// ordem devolvida é uma ordem perfeita de eliminação de g
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário (inclusive se g é direcionado)
+
+int ordem_preenchimento_minimo(grafo g, unsigned int *ordem, unsigned int *largura, unsigned int *preenchimento);
+
+//------------------------------------------------------------------------------
+// devolve 1, se g é bipartido (considerando as arestas sem direção), ou
+//         0, caso contrário
+//
+// um grafo é bipartido se seus vértices podem ser separados em dois lados
+// de forma que nenhuma aresta ligue dois vértices do mesmo lado, ou seja,
+// se ele não tem ciclo ímpar
+//
+// lado[id] (n = n_vertices(g) posições, alocadas por quem chama) recebe o
+// lado (0 ou 1) do vértice de id id; se g não é bipartido, lado fica
+// incompleto
+//
+// se g não é bipartido e ciclo não é NULL (n posições, alocadas por quem
+// chama), ciclo recebe os ids dos vértices de um ciclo ímpar de g, na
+// ordem do ciclo, e *tamanho_ciclo o seu tamanho (1 para um laço); em caso
+// de falta de memória a função devolve 0 com *tamanho_ciclo == 0
+//
+// o tempo de execução é O(|V(G)|+|E(G)|); a busca para no primeiro ciclo
+// ímpar encontrado
+
+int bipartido(grafo g, unsigned int *lado, unsigned int *ciclo, unsigned int *tamanho_ciclo);
+
 //------------------------------------------------------------------------------
 // devolve um grafo cujos vertices são cópias de vértices do grafo
-// bipartido g e cujas arestas formam um emparelhamento máximo em g
+// bipartido g e cujas arestas formam um emparelhamento máximo em g, ou
+//         NULL se g não é bipartido (ou em caso de erro)
 //
-// não verifica se g é bipartido; caso não seja, o comportamento é indefinido
+// num grafo direcionado, os arcos são considerados sem direção (como em
+// bipartido()) e cada arco do emparelhamento mantém o sentido que tem em g
 
 grafo emparelhamento_maximo(grafo g);
 
+//------------------------------------------------------------------------------
+// calcula um emparelhamento máximo no grafo bipartido g, sem construir um
+// grafo com o resultado
+//
+// par[id] (n = n_vertices(g) posições, alocadas por quem chama) recebe o id
+// do vértice emparelhado com o vértice de id id, ou UINT_MAX se ele não é
+// coberto pelo emparelhamento, e *tamanho recebe o número de arestas do
+// emparelhamento
+//
+// usa o algoritmo de Hopcroft e Karp, em tempo O(|E(G)|.sqrt(|V(G)|)),
+// depois de verificar, como bipartido(), que g é bipartido; num grafo
+// direcionado, os arcos são considerados sem direção
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário (inclusive se g não é bipartido)
+
+int emparelhamento_maximo_id(grafo g, unsigned int *par, unsigned int *tamanho);
+
+//------------------------------------------------------------------------------
+// rotula os vértices de g com os seus componentes (conexos; num grafo
+// direcionado, fracamente conexos)
+//
+// componente[id] (n = n_vertices(g) posições, alocadas por quem chama)
+// recebe o número do componente do vértice de id id; os componentes são
+// numerados a partir de 0 na ordem do menor id de cada um
+//
+// o tempo de execução é O(|V(G)|+|E(G)|)
+//
+// devolve o número de componentes de g ou
+//         0 em caso de erro (ou se g não tem vértices)
+
+unsigned int componentes(grafo g, unsigned int *componente);
+
+//------------------------------------------------------------------------------
+// versões de cordal(), emparelhamento_maximo() e emparelhamento_maximo_id()
+// que processam cada componente de g à parte, com até n_threads threads (a
+// thread que chama é uma delas)
+//
+// cada componente com arestas vira um subgrafo com ids locais, e os
+// componentes são distribuídos entre as threads do maior para o menor; os
+// resultados são os mesmos das versões sequenciais (o emparelhamento tem o
+// mesmo tamanho, mas pode ter outras arestas)
+//
+// compensam em grafos com muitos componentes; num grafo conexo só há
+// trabalho para uma thread
+//
+// num grafo direcionado, cordal_paralelo() é o mesmo que cordal(), e os
+// emparelhamentos consideram os arcos sem direção, como
+// emparelhamento_maximo_id()
+
+int cordal_paralelo(grafo g, unsigned int n_threads);
+
+grafo emparelhamento_maximo_paralelo(grafo g, unsigned int n_threads);
+
+int emparelhamento_maximo_id_paralelo(grafo g, unsigned int *par, unsigned int *tamanho, unsigned int n_threads);
+
+//------------------------------------------------------------------------------
+// estatísticas de execução: tempos (em nanossegundos, de relógio) das fases
+// de le_grafo(), escreve_grafo(), cordal() e emparelhamento_maximo() e
+// contadores, somados por todas as threads desde o início do programa ou
+// desde a última chamada a zera_estatisticas()
+//
+// os contadores são somados por todas as funções que fazem o trabalho
+// contado (por exemplo, ordem_lexicografica() também conta refinamentos e
+// arestas percorridas), e os tempos só pelas funções das fases
+
+struct estatisticas {
+    // le_grafo()
+    unsigned long long leituras;                // chamadas
+    unsigned long long leituras_cgraph;         // leituras feitas pela libcgraph
+    unsigned long long ns_leitura_texto;        // leitura do arquivo para a memória
+    unsigned long long ns_analise_dot;          // análise do texto pelo leitor próprio
+    unsigned long long ns_monta_csr;            // ordenação das arestas e montagem do CSR
+    unsigned long long ns_cgraph;               // agread()
+    unsigned long long ns_copia_cgraph;         // cópia do grafo da libcgraph e congelamento
+    unsigned long long ns_espera_cgraph;        // espera pela vez de usar a libcgraph
+
+    // escreve_grafo()
+    unsigned long long escritas;                // chamadas
+    unsigned long long ns_escrita;              // geração e escrita do texto
+
+    // cordal()
+    unsigned long long testes_cordal;           // chamadas
+    unsigned long long ns_lexbfs;               // busca em largura lexicográfica (ou por cardinalidade máxima)
+    unsigned long long ns_verifica_eliminacao;  // teste da ordem perfeita de eliminação
+
+    // emparelhamento_maximo() e emparelhamento_maximo_id()
+    unsigned long long emparelhamentos;         // chamadas
+    unsigned long long ns_biparticao;           // separação dos lados
+    unsigned long long ns_hopcroft_karp;        // emparelhamento
+    unsigned long long ns_monta_emparelhamento; // construção do grafo devolvido
+
+    // contadores
+    unsigned long long blocos_arena;            // blocos alocados para vértices, nomes e listas
+    unsigned long long bytes_arena;             // bytes desses blocos
+    unsigned long long refinamentos_lexbfs;     // classes criadas pela busca lexicográfica
+    unsigned long long fases_hopcroft_karp;     // fases com ao menos um caminho aumentante
+    unsigned long long emparelhamento_guloso;   // arestas do emparelhamento guloso inicial
+    unsigned long long caminhos_aumentantes;    // caminhos aumentantes encontrados
+    unsigned long long arestas_percorridas;     // adjacências examinadas pelas buscas
+};
+
+//------------------------------------------------------------------------------
+// liga (liga == 1) ou desliga (liga == 0) a coleta de estatísticas
+//
+// se liga_estatisticas() não é chamada, a coleta começa ligada se a
+// variável de ambiente GRAFO_ESTATISTICAS está definida e não é "0"
+//
+// desligada, a coleta custa um teste por chamada instrumentada
+
+void liga_estatisticas(int liga);
+
+//------------------------------------------------------------------------------
+// devolve 1 se a coleta de estatísticas está ligada ou
+//         0 caso contrário
+
+int estatisticas_ligadas(void);
+
+//------------------------------------------------------------------------------
+// zera todas as estatísticas
+
+void zera_estatisticas(void);
+
+//------------------------------------------------------------------------------
+// copia as estatísticas atuais para *e
+
+void le_estatisticas(struct estatisticas *e);
+
+//------------------------------------------------------------------------------
+// escreve as estatísticas atuais em output como um objeto JSON numa linha,
+// com os nomes dos campos de struct estatisticas
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
+
+int escreve_estatisticas(FILE *output);
+
 #endif
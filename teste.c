@@ -1,24 +1,350 @@
+#define _POSIX_C_SOURCE 200809L // fmemopen(), open_memstream(), sysconf()
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "grafo.h"
 
 //------------------------------------------------------------------------------
+// uso:
+//
+//   ./teste < arquivo.dot
+//
+//     lê um grafo da entrada padrão e escreve seu relatório
+//
+//   ./teste [-j threads] arquivo.dot ...
+//
+//     modo em lote: uma thread lê os arquivos seguintes enquanto os atuais
+//     são processados por um conjunto fixo de threads (por padrão, uma por
+//     processador); os relatórios são escritos na ordem dos arquivos
+//
+// com a variável de ambiente GRAFO_ESTATISTICAS=1, as estatísticas de
+// execução (ver grafo.h) são escritas em JSON na saída de erro ao final
 
-int main(void) {
-
-  grafo g = le_grafo(stdin);
+//------------------------------------------------------------------------------
+// escreve em saida o relatório do grafo g: suas propriedades, se é cordal
+// (se não for e g não é direcionado, um ciclo sem cordas), se é bipartido
+// e, se for, um emparelhamento máximo; se não for, um ciclo ímpar
+//
+// devolve 1 em caso de sucesso ou
+//         0 caso contrário
 
-  if ( !g )
-    return 1;
+static int relatorio(FILE *saida, grafo g) {
 
-  printf("nome: %s\n", nome_grafo(g));
+  fprintf(saida, "nome: %s\n", nome_grafo(g));
   int d = direcionado(g);
-  printf("%sdirecionado\n", d ? "" : "não ");
-  printf("%sponderado\n", ponderado(g) ? "" : "não ");
-  printf("%d vértices\n", n_vertices(g));
-  printf("%d arestas\n", n_arestas(g));
-
-  grafo emparelhamento = emparelhamento_maximo(g);
-//  escreve_grafo(stdout, g);
-  escreve_grafo(stdout,emparelhamento);
-  return ! (destroi_grafo(emparelhamento) && destroi_grafo(g));
+  fprintf(saida, "%sdirecionado\n", d ? "" : "não ");
+  fprintf(saida, "%sponderado\n", ponderado(g) ? "" : "não ");
+  fprintf(saida, "%d vértices\n", n_vertices(g));
+  fprintf(saida, "%d arestas\n", n_arestas(g));
+
+  unsigned int n = n_vertices(g) ? n_vertices(g) : 1;
+  unsigned int *lado = malloc(n * sizeof(unsigned int));
+  unsigned int *ciclo = malloc(n * sizeof(unsigned int));
+  unsigned int tamanho_ciclo = 0;
+  int ok = lado && ciclo;
+
+  int c = ok ? cordal_ciclo(g, ciclo, &tamanho_ciclo) : 0;
+
+  // num grafo direcionado não há ciclo sem cordas como certificado
+  if ( c < 0 )
+    fprintf(saida, "%scordal\n", cordal(g) ? "" : "não ");
+  else if ( c )
+    fprintf(saida, "cordal\n");
+  else if ( ok && tamanho_ciclo > 0 ) {
+    fprintf(saida, "não cordal, ciclo sem cordas:");
+    for (unsigned int i = 0; i < tamanho_ciclo; i++)
+      fprintf(saida, " %s", nome_vertice(vertice_id(ciclo[i], g)));
+    fprintf(saida, "\n");
+  }
+  else
+    ok = 0;
+
+  if ( ok && bipartido(g, lado, ciclo, &tamanho_ciclo) ) {
+    fprintf(saida, "bipartido\n");
+    grafo emparelhamento = emparelhamento_maximo(g);
+//    escreve_grafo(saida, g);
+    escreve_grafo(saida, emparelhamento);
+    ok = destroi_grafo(emparelhamento);
+  }
+  else if ( ok && tamanho_ciclo > 0 ) {
+    fprintf(saida, "não bipartido, ciclo ímpar:");
+    for (unsigned int i = 0; i < tamanho_ciclo; i++)
+      fprintf(saida, " %s", nome_vertice(vertice_id(ciclo[i], g)));
+    fprintf(saida, "\n");
+  }
+  else
+    ok = 0;
+
+  free(lado);
+  free(ciclo);
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+//MODO EM LOTE
+//------------------------------------------------------------------------------
+// um arquivo do lote
+
+struct tarefa {
+  const char *arquivo;
+  char *texto;       // conteúdo do arquivo, ou NULL se não pôde ser lido
+  size_t tamanho;
+  char *saida;       // relatório, escrito por uma thread de trabalho
+  size_t tam_saida;
+  int pronta;        // 1 quando o relatório está completo
+  int ok;            // 1 se o grafo foi lido e processado
+};
+
+//------------------------------------------------------------------------------
+// estado compartilhado pelas threads; todos os contadores são protegidos por
+// trava e toda mudança é anunciada em mudou
+//
+// as tarefas [escritas, lidas) estão na memória; a leitura para quando há
+// janela delas, para limitar a memória usada à frente da escrita
+
+struct lote {
+  struct tarefa *tarefas;
+  unsigned int n;
+  unsigned int lidas;     // tarefas já lidas
+  unsigned int proxima;   // próxima tarefa lida a ser processada
+  unsigned int escritas;  // tarefas cujo relatório já foi escrito
+  unsigned int janela;
+  int padding; // só pra evitar warning
+  pthread_mutex_t trava;
+  pthread_cond_t mudou;
+};
+
+//------------------------------------------------------------------------------
+// lê todo o conteúdo do arquivo de nome arquivo para um buffer alocado,
+// devolvido com seu tamanho em *tamanho
+//
+// devolve o buffer ou
+//         NULL em caso de erro
+
+static char *le_arquivo(const char *arquivo, size_t *tamanho) {
+
+  FILE *f = fopen(arquivo, "rb");
+
+  if ( !f )
+    return NULL;
+
+  size_t capacidade = 1 << 16;
+  char *texto = malloc(capacidade);
+
+  *tamanho = 0;
+  while ( texto ) {
+    *tamanho += fread(texto + *tamanho, 1, capacidade - *tamanho, f);
+    if ( *tamanho < capacidade )
+      break;
+    char *maior = realloc(texto, 2 * capacidade);
+    if ( !maior ) {
+      free(texto);
+      texto = NULL;
+    }
+    else {
+      texto = maior;
+      capacidade *= 2;
+    }
+  }
+
+  if ( texto && ferror(f) ) {
+    free(texto);
+    texto = NULL;
+  }
+  fclose(f);
+  return texto;
+}
+
+//------------------------------------------------------------------------------
+// thread de leitura: lê os arquivos do lote em ordem, à frente das threads
+// de trabalho
+
+static void *leitor(void *arg) {
+
+  struct lote *l = arg;
+
+  for (unsigned int i = 0; i < l->n; i++) {
+    pthread_mutex_lock(&l->trava);
+    while ( l->lidas - l->escritas >= l->janela )
+      pthread_cond_wait(&l->mudou, &l->trava);
+    pthread_mutex_unlock(&l->trava);
+
+    struct tarefa *t = l->tarefas + i;
+    t->texto = le_arquivo(t->arquivo, &t->tamanho);
+
+    pthread_mutex_lock(&l->trava);
+    l->lidas++;
+    pthread_cond_broadcast(&l->mudou);
+    pthread_mutex_unlock(&l->trava);
+  }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+// processa a tarefa t: constrói o grafo a partir do texto lido e escreve seu
+// relatório num buffer em memória
+
+static void processa(struct tarefa *t) {
+
+  grafo g = NULL;
+  FILE *entrada = t->texto && t->tamanho ? fmemopen(t->texto, t->tamanho, "r") : NULL;
+
+  if ( entrada ) {
+    g = le_grafo(entrada);
+    fclose(entrada);
+  }
+  free(t->texto);
+  t->texto = NULL;
+
+  FILE *saida = open_memstream(&t->saida, &t->tam_saida);
+
+  if ( saida ) {
+    fprintf(saida, "arquivo: %s\n", t->arquivo);
+    if ( g )
+      t->ok = relatorio(saida, g);
+    fclose(saida);
+  }
+  if ( !destroi_grafo(g) )
+    t->ok = 0;
+}
+
+//------------------------------------------------------------------------------
+// thread de trabalho: processa as tarefas lidas, na ordem em que ficam
+// disponíveis
+
+static void *trabalhador(void *arg) {
+
+  struct lote *l = arg;
+
+  for (;;) {
+    pthread_mutex_lock(&l->trava);
+    while ( l->proxima == l->lidas && l->lidas < l->n )
+      pthread_cond_wait(&l->mudou, &l->trava);
+    if ( l->proxima == l->n ) {
+      pthread_mutex_unlock(&l->trava);
+      return NULL;
+    }
+    struct tarefa *t = l->tarefas + l->proxima++;
+    pthread_mutex_unlock(&l->trava);
+
+    processa(t);
+
+    pthread_mutex_lock(&l->trava);
+    t->pronta = 1;
+    pthread_cond_broadcast(&l->mudou);
+    pthread_mutex_unlock(&l->trava);
+  }
+}
+
+//------------------------------------------------------------------------------
+// processa os n arquivos em arquivos[] com n_threads threads de trabalho,
+// escrevendo os relatórios em stdout na ordem dos arquivos
+//
+// devolve o número de arquivos que não puderam ser processados
+
+static unsigned int lote(char **arquivos, unsigned int n, unsigned int n_threads) {
+
+  struct lote l;
+
+  l.tarefas = calloc(n, sizeof(struct tarefa));
+  pthread_t *threads = malloc((n_threads + 1) * sizeof(pthread_t));
+  if ( !l.tarefas || !threads ) {
+    free(l.tarefas);
+    free(threads);
+    return n;
+  }
+
+  for (unsigned int i = 0; i < n; i++)
+    l.tarefas[i].arquivo = arquivos[i];
+  l.n = n;
+  l.lidas = l.proxima = l.escritas = 0;
+  l.janela = 2 * n_threads;
+  pthread_mutex_init(&l.trava, NULL);
+  pthread_cond_init(&l.mudou, NULL);
+
+  unsigned int criadas = 0;
+  if ( !pthread_create(threads, NULL, leitor, &l) )
+    for (criadas = 1; criadas <= n_threads; criadas++)
+      if ( pthread_create(threads + criadas, NULL, trabalhador, &l) )
+        break;
+
+  unsigned int falhas = 0;
+  if ( criadas == 0 ) {
+    falhas = n;
+    n = 0;
+  }
+  else if ( criadas == 1 ) {
+    // sem threads de trabalho, a própria thread principal processa todo o
+    // lote antes de escrevê-lo
+    pthread_mutex_lock(&l.trava);
+    l.janela = UINT_MAX;
+    pthread_mutex_unlock(&l.trava);
+    pthread_cond_broadcast(&l.mudou);
+    trabalhador(&l);
+  }
+
+  for (unsigned int i = 0; i < n; i++) {
+    struct tarefa *t = l.tarefas + i;
+
+    pthread_mutex_lock(&l.trava);
+    while ( !t->pronta )
+      pthread_cond_wait(&l.mudou, &l.trava);
+    pthread_mutex_unlock(&l.trava);
+
+    if ( t->saida )
+      fwrite(t->saida, 1, t->tam_saida, stdout);
+    if ( !t->ok ) {
+      fprintf(stderr, "%s: grafo não pôde ser lido ou processado\n", t->arquivo);
+      falhas++;
+    }
+    free(t->saida);
+
+    pthread_mutex_lock(&l.trava);
+    l.escritas++;
+    pthread_cond_broadcast(&l.mudou);
+    pthread_mutex_unlock(&l.trava);
+  }
+
+  for (unsigned int i = 0; i < criadas; i++)
+    pthread_join(threads[i], NULL);
+
+  pthread_cond_destroy(&l.mudou);
+  pthread_mutex_destroy(&l.trava);
+  free(threads);
+  free(l.tarefas);
+  return falhas;
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+
+  long n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+  int i = 1;
+
+  if ( i + 1 < argc && !strcmp(argv[i], "-j") ) {
+    n_threads = strtol(argv[i + 1], NULL, 10);
+    i += 2;
+  }
+  if ( n_threads < 1 )
+    n_threads = 1;
+
+  int ok;
+
+  if ( i < argc )
+    ok = lote(argv + i, (unsigned int) (argc - i), (unsigned int) n_threads) == 0;
+  else {
+    grafo g = le_grafo(stdin);
+    ok = g && relatorio(stdout, g) && destroi_grafo(g);
+  }
+
+  // com GRAFO_ESTATISTICAS definida, as estatísticas vão para a saída de erro
+  if ( estatisticas_ligadas() )
+    escreve_estatisticas(stderr);
+
+  return !ok;
 }
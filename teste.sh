@@ -1,36 +1,37 @@
 #!/bin/bash
 
-./teste < dot/4pathCordal.dot
-./teste < dot/5pathCordal.dot
-./teste < dot/5starCordal.dot
-./teste < dot/32fanCordal.dot
-./teste < dot/32poleCordal.dot
-./teste < dot/a.dot
-./teste < dot/b.dot
-./teste < dot/borboletaCordal.dot
-./teste < dot/c.dot
-./teste < dot/chordal.dot
-./teste < dot/cidades.dot
-./teste < dot/cordal.dot
-./teste < dot/cordal1.dot
-./teste < dot/cordalBull.dot
-./teste < dot/cordalCasa.dot
-./teste < dot/cordalTriangulo.dot
-./teste < dot/cricketCordal.dot
-./teste < dot/d.dot
-./teste < dot/dartoCordal.dot
-./teste < dot/diamanteCordal.dot
-./teste < dot/emacs24-dep.dot
-./teste < dot/garfoCordal.dot
-./teste < dot/jssCordal.dot
-./teste < dot/k6.dot
-./teste < dot/kiteCordal.dot
-./teste < dot/large.dot
-./teste < dot/naoCordal.dot
-./teste < dot/paises.dot
-./teste < dot/pawCordal.dot
-./teste < dot/pentagramaCordal.dot
-./teste < dot/pirulitoCordal.dot
-./teste < dot/simple.dot
-./teste < dot/teste.dot
-./teste < dot/testedir.dot
+./teste \
+	dot/4pathCordal.dot \
+	dot/5pathCordal.dot \
+	dot/5starCordal.dot \
+	dot/32fanCordal.dot \
+	dot/32poleCordal.dot \
+	dot/a.dot \
+	dot/b.dot \
+	dot/borboletaCordal.dot \
+	dot/c.dot \
+	dot/chordal.dot \
+	dot/cidades.dot \
+	dot/cordal.dot \
+	dot/cordal1.dot \
+	dot/cordalBull.dot \
+	dot/cordalCasa.dot \
+	dot/cordalTriangulo.dot \
+	dot/cricketCordal.dot \
+	dot/d.dot \
+	dot/dartoCordal.dot \
+	dot/diamanteCordal.dot \
+	dot/emacs24-dep.dot \
+	dot/garfoCordal.dot \
+	dot/jssCordal.dot \
+	dot/k6.dot \
+	dot/kiteCordal.dot \
+	dot/large.dot \
+	dot/naoCordal.dot \
+	dot/paises.dot \
+	dot/pawCordal.dot \
+	dot/pentagramaCordal.dot \
+	dot/pirulitoCordal.dot \
+	dot/simple.dot \
+	dot/teste.dot \
+	dot/testedir.dot